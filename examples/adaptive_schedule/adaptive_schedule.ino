@@ -0,0 +1,75 @@
+/**
+ * @file Example sketch in which an analog input is polled quickly while its
+ * value is changing, and slowly while it is stable.
+ *
+ * This sketch serves to illustrate the `.addAdaptiveSchedule()` method of
+ * the `SimpleEvents` class, whose callback returns its next interval.
+ *
+ * Circuit: red LED connected to pin 2, green LED connected to pin 3, and a
+ * potentiometer connected to analog pin A0.
+ *
+ * Expected circuit behavior:
+ *  + The green LED toggles every time the input is polled: slowly (every
+ *    second) when the potentiometer is left alone, and quickly (every 50
+ *    milliseconds) while it is being turned.
+ *  + The red LED is on whenever the reading is above 512.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEvents.h>
+
+SimpleEvents<> mainloop;
+
+const int RED_PIN = 2;
+const int GRN_PIN = 3;
+const int SENSOR_PIN = A0;
+
+const unsigned long FAST_POLL = 50;
+const unsigned long SLOW_POLL = 1000;
+
+int last_reading = 0;
+int grn_state = 0; // variable to track the state of green LED
+
+// function that polls the input and returns the interval to the next poll
+unsigned long poll_input(){
+  int reading = analogRead(SENSOR_PIN);
+  int change = reading - last_reading;
+  last_reading = reading;
+
+  // toggle the green LED to show the polling rate
+  grn_state = 1 - grn_state;
+  digitalWrite(GRN_PIN, grn_state);
+
+  digitalWrite(RED_PIN, (reading > 512) ? HIGH : LOW);
+
+  // poll fast while the value is changing, slow when it is stable
+  if (change > 4 || change < -4){
+    return FAST_POLL;
+  } else {
+    return SLOW_POLL;
+  }
+}
+
+void setup() {
+
+  pinMode(RED_PIN, OUTPUT);
+  pinMode(GRN_PIN, OUTPUT);
+  digitalWrite(RED_PIN, LOW);
+  digitalWrite(GRN_PIN, LOW);
+
+  // poll the input, starting with the slow interval
+  mainloop.addAdaptiveSchedule(poll_input, SLOW_POLL);
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+}
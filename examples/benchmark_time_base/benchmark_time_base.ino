@@ -0,0 +1,82 @@
+/**
+ * @file Example sketch that measures the cost of the `.run()` method of the
+ * `SimpleEvents` class with the default 32-bit time base, and with the
+ * 64-bit time base (`unsigned long long` as the third template parameter).
+ *
+ * This sketch serves to illustrate the 64-bit time base of the
+ * `SimpleEvents` class, and how to benchmark an event loop.
+ *
+ * Circuit: none needed.
+ *
+ * Serial output behaviour:
+ *  + Once at startup, the average cost of one call to `.run()` (in
+ *    microseconds and in CPU cycles) is printed for each time base, with 8
+ *    schedules that are (mostly) not yet due.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEvents.h>
+
+SimpleEvents<8, 8> loop32;
+SimpleEvents<8, 8, unsigned long long> loop64;
+
+const unsigned long N_RUNS = 10000;
+
+volatile unsigned long counter = 0;
+
+// a task that does (almost) nothing, so that only the loop itself is timed
+void count(){
+  counter++;
+}
+
+// time N_RUNS calls to .run() of the given event loop, and print the result
+template <typename Loop>
+void benchmark(const char * label, Loop & events){
+
+  unsigned long i;
+  unsigned long start = micros();
+  for (i = 0; i < N_RUNS; i++){
+    events.run();
+  }
+  unsigned long elapsed = micros() - start;
+
+  // keep 2 decimal places without floating point
+  unsigned long us_x100 = elapsed * 100UL / N_RUNS;
+
+  Serial.print(label);
+  Serial.print(": ");
+  Serial.print(us_x100 / 100);
+  Serial.print(".");
+  if (us_x100 % 100 < 10) Serial.print("0");
+  Serial.print(us_x100 % 100);
+  Serial.print(" us per run(), about ");
+  Serial.print(us_x100 * (F_CPU / 1000000UL) / 100);
+  Serial.println(" cycles");
+}
+
+void setup() {
+
+  Serial.begin(9600);
+
+  int i;
+  for (i = 0; i < 8; i++){
+    // intervals of 100, 200, ... 800 ms
+    loop32.addSchedule(count, 100UL * (i + 1));
+    loop64.addSchedule(count, 100ULL * (i + 1));
+  }
+
+  loop32.begin();
+  loop64.begin();
+
+  benchmark("32-bit time base", loop32);
+  benchmark("64-bit time base", loop64);
+
+}
+
+void loop() {
+}
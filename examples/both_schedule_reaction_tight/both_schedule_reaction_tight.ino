@@ -12,8 +12,9 @@
  *  + Once the button is pushed, the red LED immediately turns on.
  *  + Two seconds after the red LED got turned on, the red LED is turned off.
  *
- * Global variables memory footprint on Arduino Uno rev 3: 73 bytes
- * Versus 281 bytes when using default template arguments
+ * Global variables memory footprint on Arduino Uno rev 3: about 91 bytes
+ * Versus about 341 bytes when using default template arguments
+ * (both are estimates from the layout of the class, not measurements)
  */
 
 /**
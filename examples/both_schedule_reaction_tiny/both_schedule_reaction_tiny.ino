@@ -12,8 +12,8 @@
  *  + Two seconds after the red LED got turned on, the red LED is turned off.
  *
  * Global variables memory footprint on Arduino Uno rev 3: 55 bytes
- * Versus SimpleEvents<1,2>: 73 bytes
- * Versus SimpleEvents<>: 281 bytes
+ * Versus SimpleEvents<1,2>: about 91 bytes (estimate)
+ * Versus SimpleEvents<>: about 341 bytes (estimate)
  */
 
 /**
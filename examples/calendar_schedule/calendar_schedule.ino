@@ -0,0 +1,88 @@
+/**
+ * @file Example sketch with tasks that run at fixed wall-clock times: one
+ * every hour on the hour, and one every day at 02:00.
+ *
+ * This sketch serves to illustrate the `SimpleCalendar` class together with
+ * the `.addAdaptiveSchedule()` method of the `SimpleEvents` class.
+ *
+ * Circuit: red LED connected to pin 2, green LED connected to pin 3, and
+ * (optionally) a real-time clock module. Replace the body of `read_rtc()`
+ * with the call provided by your RTC library.
+ *
+ * Expected circuit behavior:
+ *  + Every hour on the hour, the green LED toggles.
+ *  + Every day at 02:00 (UTC+1), the red LED toggles.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEvents.h>
+#include <simpleCalendar.h>
+
+SimpleEvents<> mainloop;
+
+const int RED_PIN = 2;
+const int GRN_PIN = 3;
+
+// Unix time at boot, stands in for a real-time clock in this sketch
+// (2024-01-01 00:59:00 UTC, so the hourly task runs after one minute)
+const unsigned long BOOT_TIME = 1704070740UL;
+
+// function that returns the wall-clock time as Unix time (in seconds)
+/* NOTE: with an RTC library this is typically a one-liner, such as
+ * `return rtc.now().unixtime();`
+ */
+unsigned long read_rtc(){
+  return BOOT_TIME + millis() / 1000;
+}
+
+// calendar in local time UTC+1 (i.e., 3600 seconds ahead of UTC)
+SimpleCalendar calendar(read_rtc, 3600);
+
+int red_state = 0; // variable to track the state of red LED
+int grn_state = 0; // variable to track the state of green LED
+
+// hourly task: toggle the green LED, then wait for the next full hour
+unsigned long hourly_task(){
+  grn_state = 1 - grn_state;
+  digitalWrite(GRN_PIN, grn_state);
+  return calendar.untilNext(SIMPLE_CALENDAR_HOUR);
+}
+
+// daily task: toggle the red LED, then wait for the next 02:00
+unsigned long nightly_task(){
+  red_state = 1 - red_state;
+  digitalWrite(RED_PIN, red_state);
+  return calendar.untilNext(SIMPLE_CALENDAR_DAY, 2 * SIMPLE_CALENDAR_HOUR);
+}
+
+void setup() {
+
+  pinMode(RED_PIN, OUTPUT);
+  pinMode(GRN_PIN, OUTPUT);
+  digitalWrite(RED_PIN, LOW);
+  digitalWrite(GRN_PIN, LOW);
+
+  // the interval given here is only a placeholder, since the callbacks
+  // return the actual delay to the next matching instant
+  mainloop.addAdaptiveSchedule(
+    hourly_task, SIMPLE_CALENDAR_HOUR * 1000,
+    calendar.untilFirst(SIMPLE_CALENDAR_HOUR)
+  );
+  mainloop.addAdaptiveSchedule(
+    nightly_task, SIMPLE_CALENDAR_DAY * 1000,
+    calendar.untilFirst(SIMPLE_CALENDAR_DAY, 2 * SIMPLE_CALENDAR_HOUR)
+  );
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+}
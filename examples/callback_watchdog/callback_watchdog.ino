@@ -0,0 +1,103 @@
+/**
+ * @file Example sketch in which each callback declares a time budget, and
+ * the hardware watchdog resets the board if a callback hangs. After the
+ * reset, the sketch reports which callback hung.
+ *
+ * This sketch serves to illustrate the `.setBudget()` and
+ * `.setReactionBudget()` methods of the `SimpleEvents` class, together with
+ * the fault record returned by `simpleEventsFaults()`.
+ *
+ * Circuit: green LED connected to pin 3, and push button (normal LOW)
+ * connected to pin 10.
+ *
+ * Expected circuit behavior:
+ *  + Green LED toggles every 500 ms.
+ *  + Once the button is pushed, the reaction callback hangs, and (on AVR
+ *    boards such as Arduino Uno) the watchdog resets the board after 1 s.
+ *
+ * Serial output behaviour:
+ *  + At startup, the hook that hung before the last reset (if any), and the
+ *    hook that last exceeded its budget (if any), are printed.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+// turn on the time budgets (left out by default)
+// NOTE: must come BEFORE #include <simpleEvents.h>
+#define SIMPLE_EVENTS_BUDGETS
+
+// arm the watchdog with a 1 second timeout (AVR only, ignored otherwise)
+// NOTE: must come BEFORE #include <simpleEvents.h>
+#define SIMPLE_EVENTS_WATCHDOG WDTO_1S
+
+#include <simpleEvents.h>
+
+SimpleEvents<> mainloop;
+
+const int GRN_PIN = 3;
+const int BUTTON_PIN = 10;
+
+int grn_state = 0;
+
+// function that toggles the green LED, well within its budget
+void toggle_green(){
+  grn_state = 1 - grn_state;
+  digitalWrite(GRN_PIN, grn_state);
+}
+
+// function that check if the button is pressed
+bool check_button(){
+  return digitalRead(BUTTON_PIN)==HIGH;
+}
+
+// a buggy callback that never returns
+void runaway(){
+  while (true) {}
+}
+
+// function that prints a hook recorded in the fault record
+void print_hook(unsigned char kind, int id){
+  if (kind == SIMPLE_EVENTS_HOOK_SCHEDULE){
+    Serial.print("schedule #");
+  } else {
+    Serial.print("reaction #");
+  }
+  Serial.println(id);
+}
+
+void setup() {
+
+  Serial.begin(9600);
+
+  pinMode(GRN_PIN, OUTPUT);
+  pinMode(BUTTON_PIN, INPUT);
+
+  mainloop.addSchedule(toggle_green, 500);           // ID = 0
+  mainloop.addReaction(check_button, runaway, 0, 0); // ID = 0
+
+  // neither callback should take more than 5 ms
+  mainloop.setBudget(0, 5);
+  mainloop.setReactionBudget(0, 5);
+
+  // create the initial timestamp (which also reads the fault record)
+  mainloop.begin();
+
+  SimpleEventsFault & faults = simpleEventsFaults();
+  if (faults.hang_kind != SIMPLE_EVENTS_HOOK_NONE){
+    Serial.print("Hung before the last reset: ");
+    print_hook(faults.hang_kind, faults.hang_id);
+  }
+  if (faults.overrun_kind != SIMPLE_EVENTS_HOOK_NONE){
+    Serial.print("Last budget overrun: ");
+    print_hook(faults.overrun_kind, faults.overrun_id);
+  }
+
+}
+
+void loop() {
+  mainloop.run();
+}
@@ -0,0 +1,96 @@
+/**
+ * @file Example sketch with a streaming pipeline: a fast producer samples
+ * an analog input every 10 ms, and a slow consumer (which only runs every
+ * 100 ms or so) prints the samples in batches. The samples are passed
+ * through a channel, so none is lost, and the producer pauses itself when
+ * the channel is full instead of overwriting data.
+ *
+ * This sketch serves to illustrate the `SimpleChannel` class together with
+ * the `.wakeReaction()` method of the `SimpleEvents` class.
+ *
+ * Circuit: potentiometer (or other analog sensor) connected to pin A0.
+ *
+ * Serial output behaviour:
+ *  + About every 100 ms, the batch of samples taken since the last batch is
+ *    printed on one line.
+ *  + Every 5 seconds, the number of times the producer stalled is printed.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEvents.h>
+#include <simpleChannel.h>
+
+SimpleEvents<> mainloop;
+
+// up to 16 samples in flight between producer and consumer
+SimpleChannel<int, 16> samples;
+
+int producer; // id of the producer schedule
+int consumer; // id of the consumer reaction
+
+int pending = -1; // a sample that did not fit in the channel yet
+
+// producer: take a sample, or pause if the channel is full
+void produce(){
+  if (pending < 0) pending = analogRead(A0);
+  if (samples.offer(pending)){
+    pending = -1;
+  } else {
+    mainloop.pauseSchedule(producer);
+  }
+}
+
+// consumer: print everything that is available, in one batch
+void consume(){
+  int value;
+  while (samples.read(value)){
+    Serial.print(value);
+    Serial.print(" ");
+  }
+  Serial.println();
+}
+
+// called by the channel when a sample arrives in an empty channel
+void wake_consumer(){
+  mainloop.wakeReaction(consumer);
+}
+
+// called by the channel when a full channel has room again
+void resume_producer(){
+  mainloop.resumeSchedule(producer);
+}
+
+// report the number of stalls
+void report(){
+  Serial.print("Producer stalls: ");
+  Serial.println(samples.stalls());
+}
+
+void setup() {
+
+  Serial.begin(9600);
+
+  producer = mainloop.addSchedule(produce, 10);
+
+  // no trigger: the consumer runs only when woken, 100 ms after that
+  // (to let a batch build up)
+  consumer = mainloop.addReaction(nullptr, consume, 0, 100);
+
+  samples.onWake(wake_consumer);
+  samples.onSpace(resume_producer);
+
+  mainloop.addSchedule(report, 5000, 5000);
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+}
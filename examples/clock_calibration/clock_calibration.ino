@@ -0,0 +1,96 @@
+/**
+ * @file Example sketch with an hourly task that stays accurate over days,
+ * even though the `millis()` clock of the board drifts, by calibrating the
+ * `millis()` clock against a real-time clock.
+ *
+ * This sketch serves to illustrate the `SimpleClockCalibration` class
+ * together with the `.setInterval()` method of the `SimpleEvents` class.
+ *
+ * Circuit: red LED connected to pin 2, green LED connected to pin 3, and
+ * (optionally) a real-time clock module. Replace the body of `read_rtc()`
+ * with the call provided by your RTC library.
+ *
+ * Expected circuit behavior:
+ *  + Green LED toggle between on and off once per (true) hour.
+ *
+ * Serial output behaviour:
+ *  + Every 10 minutes, the estimated drift of millis() (in ppm) and the
+ *    corrected length of an hour (in ms of millis()) are printed.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEvents.h>
+#include <simpleCalibration.h>
+
+SimpleEvents<> mainloop;
+
+const int GRN_PIN = 3;
+
+const unsigned long HOUR = 3600000UL;
+
+// function that returns the wall-clock time as Unix time (in seconds)
+/* NOTE: with an RTC library this is typically a one-liner, such as
+ * `return rtc.now().unixtime();`
+ */
+unsigned long read_rtc(){
+  return 1704067200UL + millis() / 1000;
+}
+
+SimpleClockCalibration calibration;
+
+int grn_state = 0; // variable to track the state of green LED
+
+// function that toggles the green LED on and off
+void toggle_green(){
+  if (grn_state == 0){
+    digitalWrite(GRN_PIN, HIGH);
+    grn_state = 1;
+  } else {
+    digitalWrite(GRN_PIN, LOW);
+    grn_state = 0;
+  }
+}
+
+// function that feeds a reference timestamp and corrects the hourly task
+void calibrate(){
+  /* NOTE: the reference only needs a fixed origin. Unix time in ms does
+   * not fit in an unsigned long, but the wrap-around cancels out since only
+   * differences between reference timestamps are used
+   */
+  calibration.addReference(read_rtc() * 1000UL);
+
+  // the hourly task has ID 0
+  mainloop.setInterval(0, calibration.scale(HOUR));
+
+  Serial.print("Drift (ppm): ");
+  Serial.print(calibration.ppm());
+  Serial.print(", corrected hour (ms): ");
+  Serial.println(calibration.scale(HOUR));
+}
+
+void setup() {
+
+  Serial.begin(9600);
+
+  pinMode(GRN_PIN, OUTPUT);
+  digitalWrite(GRN_PIN, LOW);
+
+  // the hourly task (ID = 0)
+  mainloop.addSchedule(toggle_green, HOUR);
+
+  // feed the calibration every 10 minutes, starting right away
+  mainloop.addSchedule(calibrate, 600000UL);
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+}
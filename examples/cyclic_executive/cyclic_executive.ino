@@ -0,0 +1,104 @@
+/**
+ * @file Example sketch with four periodic tasks at 5, 10, 20 and 100 ms, run
+ * by a cyclic executive with a precomputed frame table.
+ *
+ * This sketch serves to illustrate the `CyclicEvents` class, including the
+ * detection of frame overruns.
+ *
+ * Circuit: red LED connected to pin 2, green LED connected to pin 3, and
+ * potentiometer (or other analog sensor) connected to pin A0.
+ *
+ * Expected circuit behavior:
+ *  + Red LED toggles every 100 ms.
+ *  + Green LED lights up while the (filtered) reading on A0 is above 512.
+ *
+ * Serial output behaviour:
+ *  + At startup, the minor frame, the hyperperiod and the number of frames
+ *    are printed.
+ *  + Every second, the number of frame overruns so far is printed. If a
+ *    frame overruns, the index of the frame is also printed.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <cyclicEvents.h>
+
+// up to 4 tasks, up to 32 minor frames per hyperperiod
+CyclicEvents<4, 32> executive;
+
+const int RED_PIN = 2;
+const int GRN_PIN = 3;
+const int SENSOR_PIN = A0;
+
+int reading = 0;  // latest reading of the sensor
+int filtered = 0; // smoothed reading of the sensor
+int red_state = 0;
+unsigned int ticks = 0;
+
+// 5 ms task: sample the sensor
+void sample(){
+  reading = analogRead(SENSOR_PIN);
+}
+
+// 10 ms task: smooth the readings
+void smooth(){
+  filtered += (reading - filtered) / 4;
+}
+
+// 20 ms task: update the green LED from the smoothed reading
+void update_led(){
+  digitalWrite(GRN_PIN, filtered > 512 ? HIGH : LOW);
+}
+
+// 100 ms task: blink the red LED, and report once per second
+void housekeeping(){
+  red_state = 1 - red_state;
+  digitalWrite(RED_PIN, red_state);
+
+  ticks++;
+  if (ticks % 10 == 0){
+    Serial.print("Frame overruns: ");
+    Serial.println(executive.overruns());
+  }
+}
+
+// function called whenever a frame overruns
+void report_overrun(int frame){
+  Serial.print("Overrun in frame ");
+  Serial.println(frame);
+}
+
+void setup() {
+
+  Serial.begin(9600);
+
+  pinMode(RED_PIN, OUTPUT);
+  pinMode(GRN_PIN, OUTPUT);
+
+  executive.addTask(sample, 5);
+  executive.addTask(smooth, 10);
+  // offsets spread the slower tasks over frames where fewer tasks run
+  executive.addTask(update_led, 20, 5);
+  executive.addTask(housekeeping, 100, 15);
+
+  executive.onOverrun(report_overrun);
+
+  // build the frame table and create the initial timestamp
+  executive.begin();
+
+  Serial.print("Minor frame (ms): ");
+  Serial.println(executive.minorFrame());
+  Serial.print("Hyperperiod (ms): ");
+  Serial.println(executive.hyperperiod());
+  Serial.print("Frames: ");
+  Serial.println(executive.frames());
+
+}
+
+void loop() {
+  executive.run();
+}
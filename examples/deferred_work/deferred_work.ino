@@ -0,0 +1,76 @@
+/**
+ * @file Example sketch in which three sensors are read by three schedules,
+ * and the readings are processed (averaged and printed) right after the
+ * last sensor is read, in the same iteration of the loop.
+ *
+ * This sketch serves to illustrate the `.defer()` method of the
+ * `SimpleEvents` class.
+ *
+ * Circuit: potentiometers (or other analog sensors) connected to pins A0,
+ * A1 and A2.
+ *
+ * Serial output behaviour:
+ *  + Every second, the three readings and their average are printed.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+// room for 8 deferred actions (the queue is left out by default)
+// NOTE: must come BEFORE #include <simpleEvents.h>
+#define SIMPLE_EVENTS_DEFER_MAX 8
+
+#include <simpleEvents.h>
+
+SimpleEvents<> mainloop;
+
+int readings[3]; // latest reading of each sensor
+
+// follow-up work: takes the readings as context
+void process(void * data){
+  int * values = (int *) data;
+  long total = 0;
+  int i;
+  for (i = 0; i < 3; i++){
+    Serial.print(values[i]);
+    Serial.print(" ");
+    total += values[i];
+  }
+  Serial.print("-> average ");
+  Serial.println(total / 3);
+}
+
+void read_first(){
+  readings[0] = analogRead(A0);
+}
+
+void read_second(){
+  readings[1] = analogRead(A1);
+}
+
+// the last sensor: leave the processing for the end of this pass
+void read_third(){
+  readings[2] = analogRead(A2);
+  mainloop.defer(process, readings);
+}
+
+void setup() {
+
+  Serial.begin(9600);
+
+  // all three due at the same time, in this order
+  mainloop.addSchedule(read_first, 1000);
+  mainloop.addSchedule(read_second, 1000);
+  mainloop.addSchedule(read_third, 1000);
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+}
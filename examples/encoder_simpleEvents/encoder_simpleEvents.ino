@@ -0,0 +1,99 @@
+/**
+ * @file Example sketch that adjusts the brightness of an LED with a rotary
+ * encoder, while a second LED keeps flashing.
+ *
+ * This sketch serves to illustrate the `SimpleEncoder` class: the encoder
+ * is sampled in an interrupt so no step is missed, and the event loop
+ * consumes the accumulated movement in a reaction.
+ *
+ * Circuit: encoder A output connected to pin 2, encoder B output connected
+ * to pin 3 (both are interrupt pins on Arduino Uno), red LED connected to
+ * (PWM) pin 9, and green LED connected to pin 4.
+ *
+ * Expected circuit behavior:
+ *  + Green LED toggle between on and off at 1 second interval.
+ *  + Turning the encoder clockwise or counterclockwise changes the
+ *    brightness of the red LED, faster when the encoder is turned faster.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEvents.h>
+#include <simpleEncoder.h>
+
+SimpleEvents<> mainloop;
+
+const int ENC_A_PIN = 2;
+const int ENC_B_PIN = 3;
+const int RED_PIN = 9;
+const int GRN_PIN = 4;
+
+// encoder with 4 quadrature steps per detent
+SimpleEncoder encoder(ENC_A_PIN, ENC_B_PIN);
+
+int brightness = 0; // brightness of the red LED
+int grn_state = 0; // variable to track the state of green LED
+
+// interrupt service routine: sample the encoder on every pin change
+void sample_encoder(){
+  encoder.update();
+}
+
+// function that check if the encoder has moved by at least one detent
+bool check_encoder(){
+  return encoder.available();
+}
+
+// function that consumes ALL detents accumulated since the last call
+void adjust_red(){
+  brightness += encoder.read();
+  if (brightness < 0) brightness = 0;
+  if (brightness > 255) brightness = 255;
+  analogWrite(RED_PIN, brightness);
+}
+
+// function that toggles the green LED on and off
+void toggle_green(){
+  if (grn_state == 0){
+    digitalWrite(GRN_PIN, HIGH);
+    grn_state = 1;
+  } else {
+    digitalWrite(GRN_PIN, LOW);
+    grn_state = 0;
+  }
+}
+
+void setup() {
+
+  pinMode(RED_PIN, OUTPUT);
+  pinMode(GRN_PIN, OUTPUT);
+  digitalWrite(GRN_PIN, LOW);
+  analogWrite(RED_PIN, brightness);
+
+  // read the initial state of the encoder BEFORE attaching the interrupts
+  encoder.begin();
+  attachInterrupt(digitalPinToInterrupt(ENC_A_PIN), sample_encoder, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(ENC_B_PIN), sample_encoder, CHANGE);
+
+  // detents less than 50 ms apart are multiplied by up to 8 times
+  encoder.setAcceleration(50, 8);
+
+  // adjust the brightness whenever the encoder has moved, no debounce or
+  // delay needed since the quadrature decoding rejects bounces
+  mainloop.addReaction(check_encoder, adjust_red, 0, 0);
+
+  // schedule the toggling of green LED
+  mainloop.addSchedule(toggle_green, 1000);
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+}
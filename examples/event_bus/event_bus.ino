@@ -0,0 +1,115 @@
+/**
+ * @file Example sketch with an event bus: two buttons and an analog sensor
+ * publish events on named topics, and several handlers subscribe to them.
+ * The LED handler only listens to the buttons, while the logger listens to
+ * every topic.
+ *
+ * This sketch serves to illustrate the `SimpleEventBus` class.
+ *
+ * Circuit: red LED connected to pin 2, push buttons (normal LOW) connected
+ * to pins 10 and 11, and potentiometer (or other analog sensor) connected to
+ * pin A0.
+ *
+ * Expected circuit behavior:
+ *  + The red LED is on while either button is held down.
+ *  + Every change of a button is printed on the serial port, together with
+ *    the pin number.
+ *  + Every second, the analog reading is printed on the serial port.
+ *  + Every 10 seconds, the number of dropped events (if any) is printed.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEvents.h>
+#include <simpleEventBus.h>
+
+// the topics, fixed at compile time
+enum { TOPIC_BUTTON, TOPIC_LEVEL, N_TOPICS };
+
+SimpleEvents<> mainloop;
+SimpleEventBus<N_TOPICS, 4, 8> bus;
+
+const int RED_PIN = 2;
+const int BUTTON_PINS[2] = { 10, 11 };
+
+int button_states[2] = { LOW, LOW };
+int buttons_down = 0;
+
+// publish an event for every button that changed
+void poll_buttons(){
+  int i, state;
+  for (i = 0; i < 2; i++){
+    state = digitalRead(BUTTON_PINS[i]);
+    if (state != button_states[i]){
+      button_states[i] = state;
+      bus.publish(TOPIC_BUTTON, BUTTON_PINS[i], state);
+    }
+  }
+}
+
+// publish the analog reading
+void poll_level(){
+  bus.publish(TOPIC_LEVEL, A0, analogRead(A0));
+}
+
+// handler: light the LED while any button is down
+void on_button(unsigned char topic, unsigned char pin, int state){
+  buttons_down += (state == HIGH) ? 1 : -1;
+  digitalWrite(RED_PIN, (buttons_down > 0) ? HIGH : LOW);
+}
+
+// handler: print every event
+void log_event(unsigned char topic, unsigned char pin, int value){
+  Serial.print((topic == TOPIC_BUTTON) ? "button " : "level ");
+  Serial.print(pin);
+  Serial.print(": ");
+  Serial.println(value);
+}
+
+// report dropped events, if any
+void report_drops(){
+  int t;
+  for (t = 0; t < N_TOPICS; t++){
+    if (bus.drops(t) > 0){
+      Serial.print("Dropped on topic ");
+      Serial.print(t);
+      Serial.print(": ");
+      Serial.println(bus.drops(t));
+    }
+  }
+  bus.clearDrops();
+}
+
+void setup() {
+
+  Serial.begin(9600);
+
+  pinMode(RED_PIN, OUTPUT);
+  pinMode(BUTTON_PINS[0], INPUT);
+  pinMode(BUTTON_PINS[1], INPUT);
+
+  bus.subscribe(TOPIC_BUTTON, on_button);
+  bus.subscribe(TOPIC_BUTTON, log_event);
+  bus.subscribe(TOPIC_LEVEL, log_event);
+
+  // build the subscriber table
+  bus.begin();
+
+  mainloop.addSchedule(poll_buttons, 20);
+  mainloop.addSchedule(poll_level, 1000);
+  mainloop.addSchedule(report_drops, 10000, 10000);
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+  // deliver the events published in this loop
+  bus.run();
+}
@@ -0,0 +1,106 @@
+/**
+ * @file Example sketch that lights an LED when a noisy analog input is high,
+ * after removing spikes and smoothing the input.
+ *
+ * This sketch serves to illustrate the filter stages in `simpleFilters.h`
+ * chained behind a scheduled analog read, and feeding a `SimpleThreshold`.
+ *
+ * Circuit: red LED connected to pin 2, green LED connected to pin 3, and a
+ * (noisy) analog signal connected to analog pin A0.
+ *
+ * Expected circuit behavior:
+ *  + Green LED toggle between on and off at 1 second interval.
+ *  + The red LED turns on when the smoothed reading rises to 600 or above,
+ *    and turns off when it falls to 400 or below.
+ *  + Single-sample spikes of the reading never turn on the red LED.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEvents.h>
+#include <simpleFilters.h>
+#include <simpleThreshold.h>
+
+SimpleEvents<> mainloop;
+
+const int RED_PIN = 2;
+const int GRN_PIN = 3;
+const int SENSOR_PIN = A0;
+
+// median of 3 (removes single-sample spikes), followed by an exponential
+// moving average with smoothing factor 1/8
+SimpleFilterChain<SimpleMedian<3>, SimpleEMA<3> > smoother;
+
+// hysteresis band from 400 to 600 (the pin is not read by the threshold)
+SimpleThreshold level(SENSOR_PIN, 400, 600);
+
+int grn_state = 0; // variable to track the state of green LED
+
+// function that reads, filters, and then thresholds the input
+void sample_sensor(){
+  level.update(smoother.update(analogRead(SENSOR_PIN)));
+}
+
+// function that check if the smoothed input has become high
+bool check_high(){
+  return level.crossedUp();
+}
+
+// function that check if the smoothed input has become low
+bool check_low(){
+  return level.crossedDown();
+}
+
+// function that turns the red LED on
+void turn_on_red(){
+  digitalWrite(RED_PIN, HIGH);
+}
+
+// function that turns the red LED off
+void turn_off_red(){
+  digitalWrite(RED_PIN, LOW);
+}
+
+// function that toggles the green LED on and off
+void toggle_green(){
+  if (grn_state == 0){
+    digitalWrite(GRN_PIN, HIGH);
+    grn_state = 1;
+  } else {
+    digitalWrite(GRN_PIN, LOW);
+    grn_state = 0;
+  }
+}
+
+void setup() {
+
+  pinMode(RED_PIN, OUTPUT);
+  pinMode(GRN_PIN, OUTPUT);
+  digitalWrite(RED_PIN, LOW);
+  digitalWrite(GRN_PIN, LOW);
+
+  // start the filters from the current reading rather than from 0
+  smoother.reset(analogRead(SENSOR_PIN));
+
+  // read the sensor every 20 milliseconds
+  mainloop.addSchedule(sample_sensor, 20);
+
+  // switch the red LED on crossings of the smoothed input
+  mainloop.addReaction(check_high, turn_on_red, 0, 0);
+  mainloop.addReaction(check_low, turn_off_red, 0, 0);
+
+  // schedule the toggling of green LED
+  mainloop.addSchedule(toggle_green, 1000);
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+}
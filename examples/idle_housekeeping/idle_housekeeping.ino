@@ -0,0 +1,79 @@
+/**
+ * @file Example sketch with a time-critical task (blinking an LED at a fast
+ * and steady rate) and housekeeping work (summing up a large table of
+ * statistics) that only runs while the loop has time to spare, in slices
+ * sized to the time available.
+ *
+ * This sketch serves to illustrate the `.addIdle()` method of the
+ * `SimpleEvents` class.
+ *
+ * Circuit: green LED connected to pin 3.
+ *
+ * Expected circuit behavior:
+ *  + Green LED toggle between on and off at 20 ms interval.
+ *  + Every time the whole table is summed up, the sum is printed on the
+ *    serial port.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEvents.h>
+
+SimpleEvents<> mainloop;
+
+const int GRN_PIN = 3;
+const int N_STATS = 200;
+
+int grn_state = 0; // variable to track the state of green LED
+
+int stats[N_STATS]; // the "statistics" to sum up
+int next_stat = 0;  // the next entry to add
+long stat_sum = 0;
+
+// time-critical task: toggle the green LED
+void toggle_green(){
+  grn_state = !grn_state;
+  digitalWrite(GRN_PIN, grn_state);
+}
+
+// housekeeping: add up entries until the budget (in ms) is nearly used up
+void sum_stats(unsigned long budget){
+  unsigned long start = millis();
+  // keep 1 ms in reserve for the next deadline
+  while ( (millis() - start < budget - 1) && (next_stat < N_STATS) ){
+    stat_sum += stats[next_stat++];
+  }
+  if (next_stat == N_STATS){
+    Serial.print("Sum of statistics: ");
+    Serial.println(stat_sum);
+    next_stat = 0;
+    stat_sum = 0;
+  }
+}
+
+void setup() {
+
+  int i;
+
+  Serial.begin(9600);
+
+  pinMode(GRN_PIN, OUTPUT);
+  for (i = 0; i < N_STATS; i++) stats[i] = i;
+
+  mainloop.addSchedule(toggle_green, 20);
+
+  // only run when the next deadline is more than 5 ms away
+  mainloop.addIdle(sum_stats, 5);
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+}
@@ -0,0 +1,77 @@
+/**
+ * @file Example sketch that watches a sensor which signals new data on a
+ * "data ready" pin, and raises an alarm if the sensor goes quiet.
+ *
+ * This sketch serves to illustrate the `.addMonitor()` and `.kick()`
+ * methods of the `SimpleEvents` class.
+ *
+ * Circuit: red LED connected to pin 2, green LED connected to pin 3, and
+ * the "data ready" output of a sensor (or a push button, normal LOW)
+ * connected to pin 10.
+ *
+ * Expected circuit behavior:
+ *  + Green LED flashes briefly whenever new data is ready.
+ *  + If no new data arrives for 2 seconds, the red LED turns on, until new
+ *    data arrives again.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEvents.h>
+
+SimpleEvents<> mainloop;
+
+const int RED_PIN = 2;
+const int GRN_PIN = 3;
+const int READY_PIN = 10;
+
+int sensor_monitor; // id of the monitor
+
+// function that check if new data is ready
+bool check_ready(){
+  return digitalRead(READY_PIN)==HIGH;
+}
+
+// function that reads the new data, and reports the sensor alive
+void read_sensor(){
+  // (the actual reading of the sensor would go here)
+  digitalWrite(GRN_PIN, HIGH);
+  digitalWrite(RED_PIN, LOW);
+  mainloop.kick(sensor_monitor);
+}
+
+// function that turns the green LED off after a flash
+void turn_off_green(){
+  digitalWrite(GRN_PIN, LOW);
+}
+
+// function called if the sensor goes quiet
+void raise_alarm(){
+  digitalWrite(RED_PIN, HIGH);
+}
+
+void setup() {
+
+  pinMode(RED_PIN, OUTPUT);
+  pinMode(GRN_PIN, OUTPUT);
+  pinMode(READY_PIN, INPUT);
+
+  // alarm if the sensor is not heard from for 2 seconds
+  sensor_monitor = mainloop.addMonitor(raise_alarm, 2000);
+
+  // read the sensor when data is ready, with 50 ms debounce
+  mainloop.addReaction(check_ready, read_sensor, 50, 0);
+  mainloop.addReaction(check_ready, turn_off_green, 50, 20);
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+}
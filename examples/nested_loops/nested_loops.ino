@@ -0,0 +1,131 @@
+/**
+ * @file Example sketch in which each module of the firmware (here, a blinker
+ * module and a sensor module) owns its own event loop, and the top-level
+ * loop runs the modules as child loops. The sensor module as a whole can
+ * be switched off and on by a button.
+ *
+ * This sketch serves to illustrate the `.addChild()` method of the
+ * `SimpleEvents` class.
+ *
+ * Circuit: red LED connected to pin 2, green LED connected to pin 3, push
+ * button (normal LOW) connected to pin 10, and potentiometer (or other
+ * analog sensor) connected to pin A0.
+ *
+ * Expected circuit behavior:
+ *  + Green LED toggle between on and off at 1 second interval, and red LED
+ *    at 0.3 second interval.
+ *  + Every 0.5 second, the analog reading is printed on the serial port,
+ *    and every 5 seconds, the average of the readings.
+ *  + Pushing the button switches the sensor module off (no more printing),
+ *    and pushing it again switches it back on.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEvents.h>
+
+const int RED_PIN = 2;
+const int GRN_PIN = 3;
+const int BUTTON_PIN = 10;
+
+/*
+ * The blinker module
+ */
+
+SimpleEvents<2, 1> blinker;
+
+int red_state = 0;
+int grn_state = 0;
+
+void toggle_red(){
+  red_state = !red_state;
+  digitalWrite(RED_PIN, red_state);
+}
+
+void toggle_green(){
+  grn_state = !grn_state;
+  digitalWrite(GRN_PIN, grn_state);
+}
+
+/*
+ * The sensor module
+ */
+
+SimpleEvents<2, 1> sensor;
+
+long reading_sum = 0;
+int reading_count = 0;
+
+void read_sensor(){
+  int value = analogRead(A0);
+  Serial.println(value);
+  reading_sum += value;
+  reading_count++;
+}
+
+void print_average(){
+  if (reading_count > 0){
+    Serial.print("Average: ");
+    Serial.println(reading_sum / reading_count);
+  }
+  reading_sum = 0;
+  reading_count = 0;
+}
+
+/*
+ * The top-level loop
+ */
+
+SimpleEvents<2, 1> mainloop;
+
+int sensor_hook;     // id of the sensor module in the top-level loop
+bool sensor_on = true;
+
+bool check_button(){
+  return digitalRead(BUTTON_PIN) == HIGH;
+}
+
+// switch the whole sensor module off or on
+void toggle_sensor(){
+  sensor_on = !sensor_on;
+  if (sensor_on){
+    mainloop.resumeSchedule(sensor_hook);
+  } else {
+    mainloop.pauseSchedule(sensor_hook);
+  }
+}
+
+void setup() {
+
+  Serial.begin(9600);
+
+  pinMode(RED_PIN, OUTPUT);
+  pinMode(GRN_PIN, OUTPUT);
+  pinMode(BUTTON_PIN, INPUT);
+
+  blinker.addSchedule(toggle_red, 300);
+  blinker.addSchedule(toggle_green, 1000);
+
+  sensor.addSchedule(read_sensor, 500);
+  sensor.addSchedule(print_average, 5000, 5000);
+
+  mainloop.addChild(blinker);
+  sensor_hook = mainloop.addChild(sensor);
+
+  // button with 0.5 second debounce
+  mainloop.addReaction(check_button, toggle_sensor, 500, 0);
+
+  // start the children before the parent
+  blinker.begin();
+  sensor.begin();
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+}
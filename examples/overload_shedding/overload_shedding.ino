@@ -0,0 +1,87 @@
+/**
+ * @file Example sketch in which a (simulated) slow logging task overloads
+ * the event loop whenever the button is held, and the event loop sheds the
+ * logging task to keep a critical blinking task on time.
+ *
+ * This sketch serves to illustrate the `.setCriticality()`,
+ * `.setOverload()`, and `.onOverload()` methods of the `SimpleEvents` class.
+ *
+ * Circuit: red LED connected to pin 2, green LED connected to pin 3, and
+ * push button (normal LOW) connected to pin 10.
+ *
+ * Expected circuit behavior:
+ *  + Green LED toggles every 50 ms (i.e., it looks dimly lit).
+ *  + While the button is held, the logging task takes 80 ms, so the loop
+ *    becomes overloaded: the red LED lights up, and the logging task is
+ *    skipped until the loop has recovered.
+ *
+ * Serial output behaviour:
+ *  + Every 100 ms, a counter is printed by the logging task.
+ *  + Whenever the loop enters or leaves overload, a message is printed.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+// turn on the overload detection (left out by default)
+// NOTE: must come BEFORE #include <simpleEvents.h>
+#define SIMPLE_EVENTS_OVERLOAD
+
+#include <simpleEvents.h>
+
+SimpleEvents<> mainloop;
+
+const int RED_PIN = 2;
+const int GRN_PIN = 3;
+const int BUTTON_PIN = 10;
+
+int grn_state = 0;
+unsigned long counter = 0;
+
+// critical task: toggle the green LED
+void toggle_green(){
+  grn_state = 1 - grn_state;
+  digitalWrite(GRN_PIN, grn_state);
+}
+
+// non-critical task: log a counter, slowly if the button is held
+void log_counter(){
+  Serial.println(counter++);
+  if (digitalRead(BUTTON_PIN) == HIGH) delay(80);
+}
+
+// function called when the loop enters or leaves overload
+void overload_changed(bool overloaded){
+  digitalWrite(RED_PIN, overloaded ? HIGH : LOW);
+  Serial.println(overloaded ? "Overloaded, logging paused" : "Recovered");
+}
+
+void setup() {
+
+  Serial.begin(9600);
+
+  pinMode(RED_PIN, OUTPUT);
+  pinMode(GRN_PIN, OUTPUT);
+  pinMode(BUTTON_PIN, INPUT);
+
+  // the blinking task (ID = 0) is critical, the logging task is not
+  mainloop.addSchedule(toggle_green, 50);
+  mainloop.addSchedule(log_counter, 100);
+  mainloop.setCriticality(0, 1);
+
+  // overloaded if tasks run more than 20 ms late in 3 runs in a row,
+  // then skip the tasks with criticality below 1
+  mainloop.setOverload(20, 3);
+  mainloop.onOverload(overload_changed);
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+}
@@ -0,0 +1,81 @@
+/**
+ * @file Example sketch that drives a stepper motor driver with step pulses
+ * at precise 1.5 millisecond intervals, using the precision mode of the
+ * `SimpleEvents` class on the `micros()` clock.
+ *
+ * This sketch serves to illustrate the `.setClock()`, `.setPrecision()`,
+ * and `.maxJitter()` methods of the `SimpleEvents` class.
+ *
+ * Circuit: STEP input of a stepper motor driver (e.g., A4988) connected to
+ * pin 4, and DIR input connected to pin 5.
+ *
+ * Expected circuit behavior:
+ *  + The stepper motor turns at a steady rate of one step per 1.5 ms.
+ *
+ * Serial output behaviour:
+ *  + Every second, the worst lateness (in microseconds) of the step pulses
+ *    over the last second is printed.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+// turn on the precision mode (left out by default)
+// NOTE: must come BEFORE #include <simpleEvents.h>
+#define SIMPLE_EVENTS_PRECISION
+
+#include <simpleEvents.h>
+
+SimpleEvents<2, 1> mainloop;
+
+const int STEP_PIN = 4;
+const int DIR_PIN = 5;
+
+// function that sends one step pulse to the driver
+void step(){
+  digitalWrite(STEP_PIN, HIGH);
+  delayMicroseconds(2);
+  digitalWrite(STEP_PIN, LOW);
+}
+
+// function that reports (and resets) the worst lateness of the pulses
+/* NOTE: Serial output takes time, which is why the threshold of the
+ * precision mode below is longer than the time taken by this function
+ */
+void report_jitter(){
+  Serial.print("Worst lateness (us): ");
+  Serial.println(mainloop.maxJitter());
+  mainloop.resetJitter();
+}
+
+void setup() {
+
+  Serial.begin(115200);
+
+  pinMode(STEP_PIN, OUTPUT);
+  pinMode(DIR_PIN, OUTPUT);
+  digitalWrite(DIR_PIN, HIGH);
+
+  // all times are now in microseconds
+  mainloop.setClock(micros);
+
+  // wait inside .run() for a deadline that is less than 300 us away
+  mainloop.setPrecision(300);
+
+  // one step every 1500 microseconds
+  mainloop.addSchedule(step, 1500);
+
+  // report the jitter every second
+  mainloop.addSchedule(report_jitter, 1000000, 1000000);
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+}
@@ -0,0 +1,117 @@
+/**
+ * @file Example sketch in which button presses turn on the red LED briefly,
+ * but no more than 3 times in a burst and no more than once per 5 seconds
+ * in the long run.
+ *
+ * This sketch serves to illustrate gating a reaction with a
+ * `SimpleTokenBucket`, e.g., to limit network publishes or relay toggles.
+ *
+ * Circuit: red LED connected to pin 2, green LED connected to pin 3, and push
+ * button (normal LOW) connected to pin 10.
+ *
+ * Expected circuit behavior:
+ *  + Green LED toggle between on and off at 1 second interval.
+ *  + A button press turns the red LED on for 200 milliseconds, as long as
+ *    there is a token in the bucket.
+ *  + The bucket holds up to 3 tokens and gains 1 token every 5 seconds.
+ *
+ * Serial output behaviour:
+ *  + Every 10 seconds, the number of rejected button presses is printed.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEvents.h>
+#include <simpleLimiter.h>
+
+SimpleEvents<> mainloop;
+
+const int RED_PIN = 2;
+const int GRN_PIN = 3;
+const int BUTTON_PIN = 10;
+
+// up to 3 events in a burst, then 1 event per 5000 milliseconds
+SimpleTokenBucket limiter(3, 5000);
+
+int grn_state = 0; // variable to track the state of green LED
+bool red_is_on = false; // variable to track the state of red LED
+
+// function that check if the button is pressed AND a token is available
+/* NOTE: the token is only taken (and a rejection only counted) when the
+ * button is actually pressed, thanks to the short-circuit of &&
+ */
+bool check_button(){
+  return (digitalRead(BUTTON_PIN)==HIGH) && limiter.tryAcquire();
+}
+
+// function that check if the red LED is on
+bool check_red(){
+  return red_is_on;
+}
+
+// function that turns the red LED on
+void turn_on_red(){
+  digitalWrite(RED_PIN, HIGH);
+  red_is_on = true;
+}
+
+// function that turns the red LED off
+void turn_off_red(){
+  digitalWrite(RED_PIN, LOW);
+  red_is_on = false;
+}
+
+// function that reports the number of rejected button presses
+void report_rejected(){
+  Serial.print("Rejected: ");
+  Serial.println(limiter.rejected());
+}
+
+// function that toggles the green LED on and off
+void toggle_green(){
+  if (grn_state == 0){
+    digitalWrite(GRN_PIN, HIGH);
+    grn_state = 1;
+  } else {
+    digitalWrite(GRN_PIN, LOW);
+    grn_state = 0;
+  }
+}
+
+void setup() {
+
+  Serial.begin(9600);
+
+  pinMode(RED_PIN, OUTPUT);
+  pinMode(GRN_PIN, OUTPUT);
+  digitalWrite(RED_PIN, LOW);
+  digitalWrite(GRN_PIN, LOW);
+
+  // turning on the red LED on (rate-limited) button press, no delay
+  // debounce of 250 milliseconds to account for reaction time
+  mainloop.addReaction(check_button, turn_on_red, 250, 0);
+
+  // turning off the red LED 200 milliseconds after it is turned on
+  /* NOTE: the trigger is NOT `check_button()`, which would take a second
+   * token for the same button press
+   */
+  mainloop.addReaction(check_red, turn_off_red, 200, 200);
+
+  // schedule the toggling of green LED
+  mainloop.addSchedule(toggle_green, 1000);
+
+  // schedule the report of rejected button presses
+  mainloop.addSchedule(report_rejected, 10000, 10000);
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+}
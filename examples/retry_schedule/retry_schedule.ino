@@ -0,0 +1,89 @@
+/**
+ * @file Example sketch in which a (simulated) flaky peripheral is polled
+ * with exponential backoff until it responds, or until too many attempts
+ * have failed.
+ *
+ * This sketch serves to illustrate the `.addRetry()` method of the
+ * `SimpleEvents` class.
+ *
+ * Circuit: red LED connected to pin 2, green LED connected to pin 3, and push
+ * button (normal LOW) connected to pin 10. Holding the button down plays
+ * the role of the peripheral being ready.
+ *
+ * Expected circuit behavior:
+ *  + Every attempt to reach the peripheral flashes the green LED briefly.
+ *  + Attempts are made after about 0.25, 0.5, 1, 2, ... seconds.
+ *  + If the button is held down during an attempt, the attempt succeeds
+ *    and the green LED stays on.
+ *  + If 6 attempts in a row fail, the red LED turns on.
+ *  + A button press while the red LED is on restarts the attempts.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEvents.h>
+
+SimpleEvents<> mainloop;
+
+const int RED_PIN = 2;
+const int GRN_PIN = 3;
+const int BUTTON_PIN = 10;
+
+bool has_given_up = false;
+
+// function that attempts to reach the peripheral
+// returns true on success and false on failure
+bool connect_peripheral(){
+  digitalWrite(GRN_PIN, HIGH);
+  if (digitalRead(BUTTON_PIN)==HIGH){
+    return true; // green LED stays on
+  }
+  digitalWrite(GRN_PIN, LOW);
+  return false;
+}
+
+// function called when all attempts have failed
+void report_failure(){
+  digitalWrite(RED_PIN, HIGH);
+  has_given_up = true;
+}
+
+// function that check if the button is pressed after giving up
+bool check_button(){
+  return has_given_up && (digitalRead(BUTTON_PIN)==HIGH);
+}
+
+// function that starts a new series of attempts
+void restart_attempts(){
+  digitalWrite(RED_PIN, LOW);
+  has_given_up = false;
+  // the retry schedule has ID 0; first attempt in 500 milliseconds
+  mainloop.restartSchedule(0, 500);
+}
+
+void setup() {
+
+  pinMode(RED_PIN, OUTPUT);
+  pinMode(GRN_PIN, OUTPUT);
+  digitalWrite(RED_PIN, LOW);
+  digitalWrite(GRN_PIN, LOW);
+
+  // first attempt 1 second after start, then back off from 250 milliseconds
+  // and give up after 6 failed attempts (ID = 0)
+  mainloop.addRetry(connect_peripheral, report_failure, 250, 6, 1000);
+
+  // restart the attempts on button press, after giving up
+  mainloop.addReaction(check_button, restart_attempts, 250, 0);
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+}
@@ -0,0 +1,105 @@
+/**
+ * @file Example sketch that samples an analog sensor at 1 kHz and reports
+ * the peak-to-peak amplitude of every block of 64 samples over Serial.
+ *
+ * This sketch serves to illustrate the `SimpleSampler` class: a high-rate
+ * schedule only stores the samples, while the (slower) processing runs in
+ * a reaction once a whole block is available.
+ *
+ * Circuit: green LED connected to pin 3, and a vibration sensor (or any
+ * analog signal) connected to analog pin A0.
+ *
+ * Expected circuit behavior:
+ *  + Green LED toggle between on and off at 1 second interval.
+ *
+ * Serial output behaviour:
+ *  + About 15 times per second, the peak-to-peak amplitude of the last 64
+ *    samples is printed, followed by the number of dropped samples so far
+ *    (which should stay at 0).
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEvents.h>
+#include <simpleSampler.h>
+
+SimpleEvents<> mainloop;
+
+const int GRN_PIN = 3;
+const int SENSOR_PIN = A0;
+
+// ring of 2 blocks of 64 integer samples each
+SimpleSampler<int, 64, 2> sampler;
+
+int grn_state = 0; // variable to track the state of green LED
+
+// function that takes ONE sample, called every millisecond
+void take_sample(){
+  sampler.push(analogRead(SENSOR_PIN));
+}
+
+// function that check if a full block is waiting to be processed
+bool check_block(){
+  return sampler.ready();
+}
+
+// function that processes a whole block of samples at once
+void report_amplitude(const int * data, int count){
+  int lo = data[0];
+  int hi = data[0];
+
+  for (int i = 1; i < count; i++){
+    if (data[i] < lo) lo = data[i];
+    if (data[i] > hi) hi = data[i];
+  }
+
+  Serial.print(hi - lo);
+  Serial.print(" (dropped: ");
+  Serial.print(sampler.overruns());
+  Serial.println(")");
+}
+
+// function that hands the oldest full block to `report_amplitude()`
+void process_block(){
+  sampler.process(report_amplitude);
+}
+
+// function that toggles the green LED on and off
+void toggle_green(){
+  if (grn_state == 0){
+    digitalWrite(GRN_PIN, HIGH);
+    grn_state = 1;
+  } else {
+    digitalWrite(GRN_PIN, LOW);
+    grn_state = 0;
+  }
+}
+
+void setup() {
+
+  Serial.begin(115200);
+
+  pinMode(GRN_PIN, OUTPUT);
+  digitalWrite(GRN_PIN, LOW);
+
+  // sample every millisecond, i.e., at 1 kHz
+  mainloop.addSchedule(take_sample, 1);
+
+  // process a block whenever one is full
+  mainloop.addReaction(check_block, process_block, 0, 0);
+
+  // schedule the toggling of green LED
+  mainloop.addSchedule(toggle_green, 1000);
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+}
@@ -0,0 +1,89 @@
+/**
+ * @file Example sketch that analyzes a set of schedules and reactions
+ * before running them: it reports the peak and average load of the event
+ * loop, as well as the deadline misses, and suggests delay_start values
+ * that reduce the peak load.
+ *
+ * This sketch serves to illustrate the `SimpleEventsAnalyzer` class.
+ *
+ * Circuit: none needed.
+ *
+ * Serial output behaviour:
+ *  + Once at startup, the report for the schedules as given, then the
+ *    suggested delay_start of each schedule, then the report for the
+ *    schedules with the suggested delay_start.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEventsAnalyzer.h>
+
+const int N_SCHD = 4;
+
+// intervals (in ms) of the schedules, as given to .addSchedule()
+const unsigned long INTERVALS[N_SCHD] = { 5, 10, 20, 100 };
+
+// measured cost (in us) of each callback, e.g., by timing it with micros()
+const unsigned long COSTS[N_SCHD] = { 800, 1500, 3000, 4000 };
+
+// function that prints the report of an analyzer
+void report(SimpleEventsAnalyzer<4, 1> & analyzer){
+  Serial.print("  hyperperiod (ms): ");
+  Serial.println(analyzer.hyperperiod());
+  Serial.print("  peak callbacks per run(): ");
+  Serial.println(analyzer.peakCallbacks());
+  Serial.print("  peak cost per run() (us): ");
+  Serial.println(analyzer.peakCost());
+  Serial.print("  average load (%): ");
+  Serial.println(100 * analyzer.averageLoad());
+  Serial.print("  deadline misses per hyperperiod: ");
+  Serial.println(analyzer.misses());
+}
+
+void setup() {
+
+  Serial.begin(9600);
+
+  int i;
+
+  // the schedules as first written: all start right away
+  SimpleEventsAnalyzer<4, 1> before;
+  for (i = 0; i < N_SCHD; i++){
+    before.addSchedule(INTERVALS[i], 0, COSTS[i]);
+  }
+  // a button reaction with 200 ms debounce and a 500 us callback
+  before.addReaction(200, 0, 500);
+
+  if (!before.analyze()){
+    Serial.println("Hyperperiod too long to analyze");
+    return;
+  }
+  Serial.println("As given:");
+  report(before);
+
+  Serial.print("Suggested peak cost (us): ");
+  Serial.println(before.suggestOffsets());
+
+  // the same schedules with the suggested delay_start
+  SimpleEventsAnalyzer<4, 1> after;
+  for (i = 0; i < N_SCHD; i++){
+    Serial.print("  delay_start of schedule #");
+    Serial.print(i);
+    Serial.print(": ");
+    Serial.println(before.suggestedOffset(i));
+    after.addSchedule(INTERVALS[i], before.suggestedOffset(i), COSTS[i]);
+  }
+  after.addReaction(200, 0, 500);
+
+  after.analyze();
+  Serial.println("With suggested delay_start:");
+  report(after);
+
+}
+
+void loop() {
+}
@@ -0,0 +1,103 @@
+/**
+ * @file Example sketch that saves the timing state of the event loop before
+ * going to sleep, and restores it afterward, so that the schedules resume
+ * in phase instead of starting over.
+ *
+ * This sketch serves to illustrate the `.snapshot()` and `.restore()`
+ * methods of the `SimpleEvents` class. To keep the sketch portable, the
+ * "sleep" is a plain `delay()`; on a real board, replace `go_to_sleep()` by
+ * the deep sleep of the board, and keep the snapshot in memory that
+ * survives the sleep (e.g., the RTC memory, or the EEPROM).
+ *
+ * Circuit: green LED connected to pin 3, and push button (normal LOW)
+ * connected to pin 10.
+ *
+ * Expected circuit behavior:
+ *  + Green LED toggle between on and off at 1 second interval.
+ *  + Every 10 seconds, a message is printed on the serial port.
+ *  + Once the button is pushed, the board "sleeps" for 3.5 seconds, and
+ *    then the LED and the messages carry on in the same rhythm as if it had
+ *    not slept.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEvents.h>
+
+const int GRN_PIN = 3;
+const int BUTTON_PIN = 10;
+const unsigned long SLEEP_TIME = 3500;
+
+SimpleEvents<2, 1> mainloop;
+
+// the snapshot, large enough for any SimpleEvents<2, 1>
+unsigned char blob[SimpleEvents<2, 1>::SNAPSHOT_MAX];
+int blob_size = 0;
+
+int grn_state = 0; // variable to track the state of green LED
+bool sleep_requested = false;
+
+void toggle_green(){
+  grn_state = !grn_state;
+  digitalWrite(GRN_PIN, grn_state);
+}
+
+void print_message(){
+  Serial.println("Still in phase");
+}
+
+bool check_button(){
+  return digitalRead(BUTTON_PIN) == HIGH;
+}
+
+// sleep outside of .run(), at the end of the loop
+void request_sleep(){
+  sleep_requested = true;
+}
+
+// stands in for the deep sleep of the board
+void go_to_sleep(unsigned long duration){
+  Serial.println("Going to sleep");
+  delay(duration);
+  Serial.println("Woke up");
+}
+
+void add_hooks(){
+  mainloop.addSchedule(toggle_green, 1000);
+  mainloop.addSchedule(print_message, 10000, 10000);
+  // button with 1 second debounce
+  mainloop.addReaction(check_button, request_sleep, 1000, 0);
+}
+
+void setup() {
+
+  Serial.begin(9600);
+
+  pinMode(GRN_PIN, OUTPUT);
+  pinMode(BUTTON_PIN, INPUT);
+
+  add_hooks();
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+
+  mainloop.run();
+
+  if (sleep_requested){
+    sleep_requested = false;
+    blob_size = mainloop.snapshot(blob, sizeof(blob));
+    go_to_sleep(SLEEP_TIME);
+    // after a real deep sleep, setup() would run again, and call
+    // .restore() instead of .begin() (after adding the same hooks)
+    if (!mainloop.restore(blob, blob_size, SLEEP_TIME)) mainloop.begin();
+  }
+
+}
@@ -0,0 +1,87 @@
+/**
+ * @file Example sketch with a data path of "read two sensors, then filter,
+ * then publish", in which each stage runs as soon as the stages it depends
+ * on have completed, within the same iteration of the event loop.
+ *
+ * This sketch serves to illustrate the `SimpleTaskGraph` class together
+ * with the `SimpleEvents` class.
+ *
+ * Circuit: two potentiometers (or other analog sensors) connected to pins
+ * A0 and A1.
+ *
+ * Serial output behaviour:
+ *  + Every 500 ms, the filtered sum of the two readings is printed.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEvents.h>
+#include <simpleTaskGraph.h>
+
+SimpleEvents<> mainloop;
+SimpleTaskGraph<4> pipeline;
+
+int reading_a = 0;
+int reading_b = 0;
+long filtered = 0;
+
+// stage 1: read the sensors (these two nodes do not depend on anything)
+bool read_a(){
+  reading_a = analogRead(A0);
+  return true;
+}
+
+bool read_b(){
+  reading_b = analogRead(A1);
+  return true;
+}
+
+// stage 2: filter, once BOTH readings are in
+bool filter(){
+  filtered += ((long) reading_a + reading_b - filtered) / 4;
+  return true;
+}
+
+// stage 3: publish the filtered value
+bool publish(){
+  Serial.println(filtered);
+  return true;
+}
+
+// function that runs the whole pipeline once
+void run_pipeline(){
+  pipeline.run();
+}
+
+void setup() {
+
+  Serial.begin(9600);
+
+  int a = pipeline.addNode(read_a);
+  int b = pipeline.addNode(read_b);
+  int f = pipeline.addNode(filter);
+  int p = pipeline.addNode(publish);
+
+  pipeline.addDependency(f, a); // filter waits for read_a...
+  pipeline.addDependency(f, b); // ...and for read_b
+  pipeline.addDependency(p, f); // publish waits for filter
+
+  if (!pipeline.build()){
+    Serial.println("The pipeline has a cycle!");
+  }
+
+  // run the pipeline every 500 ms
+  mainloop.addSchedule(run_pipeline, 500);
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+}
@@ -0,0 +1,100 @@
+/**
+ * @file Example sketch of a simple thermostat: a heater (represented by the
+ * red LED) is switched on when the temperature falls below a threshold, and
+ * switched off when it rises above another.
+ *
+ * This sketch serves to illustrate the `SimpleThreshold` class, whose
+ * analog input is sampled by a schedule rather than on every loop.
+ *
+ * Circuit: red LED connected to pin 2, green LED connected to pin 3, and a
+ * temperature sensor (whose reading increases with temperature, e.g., a
+ * thermistor in a voltage divider) connected to analog pin A0.
+ *
+ * Expected circuit behavior:
+ *  + Green LED toggle between on and off at 1 second interval.
+ *  + The red LED turns on when the reading drops to 480 or below.
+ *  + The red LED turns off when the reading rises to 520 or above.
+ *  + Readings between 480 and 520 never change the state of the red LED.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEvents.h>
+#include <simpleThreshold.h>
+
+SimpleEvents<> mainloop;
+
+const int RED_PIN = 2;
+const int GRN_PIN = 3;
+const int SENSOR_PIN = A0;
+
+// hysteresis band from 480 to 520, each sample averaged over 4 readings
+SimpleThreshold thermostat(SENSOR_PIN, 480, 520, 4);
+
+int grn_state = 0; // variable to track the state of green LED
+
+// function that samples the sensor, called by a schedule
+void sample_sensor(){
+  thermostat.sample();
+}
+
+// function that check if the temperature has fallen below the band
+bool check_cold(){
+  return thermostat.crossedDown();
+}
+
+// function that check if the temperature has risen above the band
+bool check_warm(){
+  return thermostat.crossedUp();
+}
+
+// function that turns the heater (red LED) on
+void turn_on_heater(){
+  digitalWrite(RED_PIN, HIGH);
+}
+
+// function that turns the heater (red LED) off
+void turn_off_heater(){
+  digitalWrite(RED_PIN, LOW);
+}
+
+// function that toggles the green LED on and off
+void toggle_green(){
+  if (grn_state == 0){
+    digitalWrite(GRN_PIN, HIGH);
+    grn_state = 1;
+  } else {
+    digitalWrite(GRN_PIN, LOW);
+    grn_state = 0;
+  }
+}
+
+void setup() {
+
+  pinMode(RED_PIN, OUTPUT);
+  pinMode(GRN_PIN, OUTPUT);
+  digitalWrite(RED_PIN, LOW);
+  digitalWrite(GRN_PIN, LOW);
+
+  // read the sensor every 500 milliseconds (and NOT on every loop)
+  mainloop.addSchedule(sample_sensor, 500);
+
+  // switch the heater on band crossings only
+  mainloop.addReaction(check_cold, turn_on_heater, 0, 0);
+  mainloop.addReaction(check_warm, turn_off_heater, 0, 0);
+
+  // schedule the toggling of green LED
+  mainloop.addSchedule(toggle_green, 1000);
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+}
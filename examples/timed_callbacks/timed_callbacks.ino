@@ -0,0 +1,105 @@
+/**
+ * @file Example sketch in which an LED "breathes" smoothly, with its
+ * brightness computed from the loop time given to the callback, and the
+ * worst lateness of the callback is reported over Serial.
+ *
+ * This sketch serves to illustrate the `.addTimedSchedule()` and
+ * `.addTimedReaction()` methods of the `SimpleEvents` class, whose
+ * callbacks receive the current time and their lateness as arguments.
+ *
+ * Circuit: red LED connected to (PWM) pin 9, green LED connected to pin 3,
+ * and push button (normal LOW) connected to pin 10.
+ *
+ * Expected circuit behavior:
+ *  + Red LED fades in and out with a period of 2 seconds.
+ *  + Once the button is pushed, the green LED turns on for 1 second.
+ *
+ * Serial output behaviour:
+ *  + Every 5 seconds, the worst lateness (in ms) of the fading callback
+ *    over the last 5 seconds is printed.
+ *  + Whenever the green LED turns off, its lateness is printed.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#include <simpleEvents.h>
+
+SimpleEvents<> mainloop;
+
+const int RED_PIN = 9;
+const int GRN_PIN = 3;
+const int BUTTON_PIN = 10;
+
+unsigned long worst_lateness = 0;
+
+// function that sets the brightness of the red LED from the loop time
+/* NOTE: using `now` rather than counting calls means that a late call
+ * still produces the right brightness, without reading millis() again
+ */
+void fade_red(unsigned long now, unsigned long lateness){
+  unsigned long phase = now % 2000;
+  if (phase < 1000){
+    analogWrite(RED_PIN, phase * 255 / 1000);
+  } else {
+    analogWrite(RED_PIN, (2000 - phase) * 255 / 1000);
+  }
+
+  if (lateness > worst_lateness) worst_lateness = lateness;
+}
+
+// function that reports (and resets) the worst lateness
+void report_lateness(){
+  Serial.print("Worst lateness of fade_red(): ");
+  Serial.println(worst_lateness);
+  worst_lateness = 0;
+}
+
+// function that check if the button is pressed
+bool check_button(){
+  return digitalRead(BUTTON_PIN)==HIGH;
+}
+
+// function that turns the green LED on
+void turn_on_green(){
+  digitalWrite(GRN_PIN, HIGH);
+}
+
+// function that turns the green LED off and reports its lateness
+void turn_off_green(unsigned long now, unsigned long lateness){
+  digitalWrite(GRN_PIN, LOW);
+  Serial.print("Green LED turned off late by: ");
+  Serial.println(lateness);
+}
+
+void setup() {
+
+  Serial.begin(9600);
+
+  pinMode(RED_PIN, OUTPUT);
+  pinMode(GRN_PIN, OUTPUT);
+  digitalWrite(GRN_PIN, LOW);
+
+  // update the brightness of the red LED every 20 milliseconds
+  mainloop.addTimedSchedule(fade_red, 20);
+
+  // report the worst lateness every 5 seconds
+  mainloop.addSchedule(report_lateness, 5000, 5000);
+
+  // turning on the green LED on button press, no delay
+  mainloop.addReaction(check_button, turn_on_green, 1000, 0);
+
+  // turning off the green LED 1 second after the button press
+  mainloop.addTimedReaction(check_button, turn_off_green, 1000, 1000);
+
+  // create the initial timestamp
+  mainloop.begin();
+
+}
+
+void loop() {
+  mainloop.run();
+}
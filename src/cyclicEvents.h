@@ -0,0 +1,280 @@
+/**
+ * @file Implement a `CyclicEvents` class, a cyclic executive for sets of
+ * periodic tasks whose periods are (small) multiples of a common base, such
+ * as tasks at 5, 10, 20 and 100 ms.
+ *
+ * Rather than comparing a timestamp per task in every loop (as `SimpleEvents`
+ * does), `CyclicEvents` works out the whole timing up front in `.begin()`:
+ * the minor frame (the greatest common divisor of all periods and offsets),
+ * the hyperperiod or major frame (the least common multiple of all periods),
+ * and a table that lists, for each minor frame in the hyperperiod, the tasks
+ * to run in that frame. Each `.run()` then does a single time comparison, and
+ * at the start of a new minor frame calls the tasks listed in the table.
+ * Since the order and the set of tasks in each frame is fixed, the timing of
+ * the whole task set can be checked (and certified) from the table alone.
+ *
+ * A frame that is not finished before the next one should start is a frame
+ * overrun. Overruns are counted and (optionally) reported to a callback; the
+ * frames that follow are run back to back until the executive catches up,
+ * so that no task is ever skipped.
+ *
+ * NOTE: due to the use of template, all functionalities of the `CyclicEvents`
+ * class are implemented directly in the `cyclicEvents.h` header file. In
+ * other words, there is no separated `.cpp` file.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#ifndef SIMPLE_EVENTS_CYCLIC_H_
+#define SIMPLE_EVENTS_CYCLIC_H_
+
+// typedef for various function types
+typedef void cyclicEventsAction();
+typedef void cyclicEventsOverrun(int);
+
+/**
+ * class declaration for the CyclicEvents class.
+ * @param - NO input parameters to the constructor. However, template
+ *     parameters that controls the maximum number of tasks (at most 32) and
+ *     the maximum number of minor frames in a hyperperiod may optionally be
+ *     supplied.
+ */
+template <int T_MAX = 8, int F_MAX = 32>
+class CyclicEvents {
+
+    static_assert(T_MAX <= 32, "CyclicEvents: at most 32 tasks");
+
+  private:
+    int last_task = -1;
+
+    cyclicEventsAction * task_calls[T_MAX] = { nullptr };
+    unsigned long task_periods[T_MAX] = { 0 };
+    unsigned long task_offsets[T_MAX] = { 0 };
+
+    // bit i of frame_masks[f] is set if task i runs in minor frame f
+    unsigned long frame_masks[F_MAX] = { 0 };
+
+    unsigned long minor = 0;
+    unsigned long hyper = 0;
+    int n_frames = 0;
+
+    int frame = 0;
+    unsigned long frame_due = 0;
+
+    unsigned int overrun_count = 0;
+    cyclicEventsOverrun * overrun_call = nullptr;
+
+    static unsigned long gcd(unsigned long, unsigned long);
+
+  public:
+    int addTask(cyclicEventsAction *, unsigned long, unsigned long = 0);
+    void onOverrun(cyclicEventsOverrun *);
+    unsigned long minorFrame();
+    unsigned long hyperperiod();
+    int frames();
+    unsigned int overruns();
+    void clearOverruns();
+    unsigned long begin();
+    void run();
+};
+
+/*
+ * Greatest common divisor, with gcd(0, b) = b.
+ */
+template <int T_MAX, int F_MAX>
+unsigned long CyclicEvents<T_MAX, F_MAX>::gcd(unsigned long a, unsigned long b){
+    unsigned long t;
+    while (b != 0){
+        t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+};
+
+/**
+ * Add a new periodic task to the cyclic executive.
+ * @param callback - (Pointer to) function to callback once per period.
+ * @param period - Time (in ms) between successive runs of the callback.
+ * @param offset - Time (in ms) from the start of each period to the run
+ *     of the callback, which can be used to spread the tasks over different
+ *     minor frames. Default = 0.
+ * @returns the id of the task (for internal use), -1 if the maximum number
+ *     of tasks is reached or the period is 0.
+ */
+template <int T_MAX, int F_MAX>
+int CyclicEvents<T_MAX, F_MAX>::addTask(
+    cyclicEventsAction * callback, unsigned long period, unsigned long offset
+) {
+
+    if ( (last_task >= T_MAX - 1) || (period == 0) ) return -1;
+
+    last_task++;
+    task_calls[last_task] = callback;
+    task_periods[last_task] = period;
+    task_offsets[last_task] = offset % period;
+
+    return last_task;
+};
+
+/**
+ * Set the function to call when a frame overrun is detected.
+ * @param callback - (Pointer to) function that takes the index of the minor
+ *     frame that overran as input.
+ * @returns No explicit return.
+ */
+template <int T_MAX, int F_MAX>
+void CyclicEvents<T_MAX, F_MAX>::onOverrun(cyclicEventsOverrun * callback){
+    overrun_call = callback;
+};
+
+/**
+ * Get the length of the minor frame, as computed by `.begin()`.
+ * @param - No input parameter
+ * @returns The length (in ms) of the minor frame.
+ */
+template <int T_MAX, int F_MAX>
+unsigned long CyclicEvents<T_MAX, F_MAX>::minorFrame(){
+    return minor;
+};
+
+/**
+ * Get the hyperperiod (the length of the major frame), as computed by
+ * `.begin()`.
+ * @param - No input parameter
+ * @returns The hyperperiod (in ms), or 0 if there is no task or if the
+ *     frame table does not fit.
+ */
+template <int T_MAX, int F_MAX>
+unsigned long CyclicEvents<T_MAX, F_MAX>::hyperperiod(){
+    return hyper;
+};
+
+/**
+ * Get the number of minor frames in the hyperperiod, as computed by
+ * `.begin()`.
+ * @param - No input parameter
+ * @returns The number of minor frames, or 0 if there is no task or if the
+ *     frame table needs more than F_MAX frames (in which case `.run()`
+ *     does nothing).
+ */
+template <int T_MAX, int F_MAX>
+int CyclicEvents<T_MAX, F_MAX>::frames(){
+    return n_frames;
+};
+
+/**
+ * Get the number of frame overruns since the last `.clearOverruns()`.
+ * @param - No input parameter
+ * @returns The number of frame overruns.
+ */
+template <int T_MAX, int F_MAX>
+unsigned int CyclicEvents<T_MAX, F_MAX>::overruns(){
+    return overrun_count;
+};
+
+/**
+ * Reset the number of frame overruns to 0.
+ * @param - No input parameter
+ * @returns No explicit return.
+ */
+template <int T_MAX, int F_MAX>
+void CyclicEvents<T_MAX, F_MAX>::clearOverruns(){
+    overrun_count = 0;
+};
+
+/**
+ * Build the frame table and store the initial timestamp.
+ *
+ * The `.begin()` method should be called ONCE, AFTER all tasks are added
+ * (via `.addTask()`), but BEFORE the `.run()` method is ever called. Check
+ * `.frames()` afterward to make sure that the frame table fits in F_MAX
+ * frames.
+ *
+ * @param - No input parameter
+ * @returns the timestamp at which the first minor frame starts (i.e., the
+ *     first `.run()` runs the tasks of frame 0 right away), or 0 if there is
+ *     no frame table to run.
+ */
+template <int T_MAX, int F_MAX>
+unsigned long CyclicEvents<T_MAX, F_MAX>::begin(){
+
+    int i, f;
+
+    minor = 0;
+    hyper = 0;
+    n_frames = 0;
+
+    if (last_task < 0) return 0;
+    hyper = 1;
+
+    for (i = 0; i <= last_task; i++){
+        minor = gcd(minor, task_periods[i]);
+        minor = gcd(minor, task_offsets[i]);
+    }
+
+    for (i = 0; i <= last_task; i++){
+        hyper = hyper / gcd(hyper, task_periods[i]) * task_periods[i];
+        // give up as soon as the table cannot fit
+        if (hyper / minor > (unsigned long) F_MAX){
+            hyper = 0;
+            return 0;
+        }
+    }
+
+    n_frames = (int) (hyper / minor);
+
+    for (f = 0; f < n_frames; f++){
+        frame_masks[f] = 0;
+        for (i = 0; i <= last_task; i++){
+            if ((f * minor) % task_periods[i] == task_offsets[i]){
+                frame_masks[f] |= (1UL << i);
+            }
+        }
+    }
+
+    frame = 0;
+    frame_due = millis();
+
+    return frame_due;
+};
+
+/**
+ * Run the tasks of the current minor frame, if it has started and has not
+ * been run yet.
+ *
+ * In arduino the `.run()` method is intended to be used inside the
+ * `loop()` function so as to create an event LOOP.
+ *
+ * @param - No input parameter
+ * @returns No explicit return.
+ */
+template <int T_MAX, int F_MAX>
+void CyclicEvents<T_MAX, F_MAX>::run(){
+
+    // the single time comparison per loop (safe across millis() rollover)
+    if ( (n_frames == 0) || ((long) (millis() - frame_due) < 0) ) return;
+
+    int i;
+    unsigned long mask;
+
+    for (i = 0, mask = frame_masks[frame]; mask != 0; i++, mask >>= 1){
+        if (mask & 1UL) (* task_calls[i])();
+    }
+
+    // overrun: the frame finished after the next frame should have started
+    if (millis() - frame_due >= minor){
+        overrun_count++;
+        if (overrun_call != nullptr) (* overrun_call)(frame);
+    }
+
+    frame_due += minor;
+    frame++;
+    if (frame == n_frames) frame = 0;
+};
+
+#endif
@@ -0,0 +1,146 @@
+/**
+ * @file Implement a `SimpleCalendar` class that maps wall-clock times (e.g.,
+ * "every day at 02:00", or "every hour on the hour") to delays for the
+ * `millis()`-based event loops of `SimpleEvents` and `TinyEvents`.
+ *
+ * The wall-clock time is read from a pluggable time source: a (pointer to)
+ * function that returns the number of seconds since a fixed origin at
+ * midnight, such as the Unix time reported by most real-time clock (RTC)
+ * libraries. The calendar only reads the time source when asked for the
+ * delay until the next matching instant, so a calendar-driven task costs
+ * a single deadline in the event loop and no per-loop evaluation.
+ *
+ * In typical use case, the calendar task is added with
+ * `.addAdaptiveSchedule()` of `SimpleEvents`: the initial delay is given by
+ * `.untilFirst()`, and the callback returns `.untilNext()` so that each run
+ * re-arms the schedule for the next matching instant. Since the delay is
+ * recomputed from the wall clock every time, the schedule neither drifts
+ * with the `millis()` clock nor loses its phase on reboot.
+ *
+ * NOTE: all functionalities of the `SimpleCalendar` class are implemented
+ * directly in the `simpleCalendar.h` header file. In other words, there is
+ * no separated `.cpp` file.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#ifndef SIMPLE_EVENTS_CALENDAR_H_
+#define SIMPLE_EVENTS_CALENDAR_H_
+
+// typedef for the time source: returns seconds since an origin at midnight
+typedef unsigned long simpleCalendarSource();
+
+// common calendar periods, in seconds
+#define SIMPLE_CALENDAR_MINUTE 60UL
+#define SIMPLE_CALENDAR_HOUR 3600UL
+#define SIMPLE_CALENDAR_DAY 86400UL
+#define SIMPLE_CALENDAR_WEEK 604800UL
+
+/**
+ * class declaration for the SimpleCalendar class.
+ * @param source - (Pointer to) function that returns the wall-clock time,
+ *     in seconds since an origin at midnight (e.g., Unix time).
+ * @param utc_offset - Offset (in seconds) added to the time source to get
+ *     local time, e.g., 3600 for UTC+1 if the source returns UTC.
+ *     Default = 0.
+ */
+class SimpleCalendar {
+
+  private:
+    simpleCalendarSource * source;
+    long utc_offset;
+
+    unsigned long secondsUntil(unsigned long, unsigned long, unsigned long);
+
+  public:
+    SimpleCalendar(simpleCalendarSource *, long = 0);
+    void setUtcOffset(long);
+    unsigned long now();
+    unsigned long untilFirst(unsigned long, unsigned long = 0);
+    unsigned long untilNext(unsigned long, unsigned long = 0);
+};
+
+/**
+ * Constructor of the SimpleCalendar class.
+ * @param source - (Pointer to) function that returns the wall-clock time,
+ *     in seconds since an origin at midnight.
+ * @param utc_offset - Offset (in seconds) added to the time source to get
+ *     local time. Default = 0.
+ */
+inline SimpleCalendar::SimpleCalendar(
+    simpleCalendarSource * source, long utc_offset
+) : source(source), utc_offset(utc_offset) {};
+
+/**
+ * Change the offset between the time source and local time, e.g., when
+ * daylight saving time starts or ends.
+ * @param utc_offset - Offset (in seconds) added to the time source.
+ * @returns No explicit return.
+ */
+inline void SimpleCalendar::setUtcOffset(long utc_offset){
+    this->utc_offset = utc_offset;
+};
+
+/**
+ * Get the current local time.
+ * @param - No input parameter
+ * @returns The local time, in seconds since the origin of the time source.
+ */
+inline unsigned long SimpleCalendar::now(){
+    return (* source)() + (unsigned long) utc_offset;
+};
+
+/*
+ * Seconds from `from` until the first instant at or after it that lies at
+ * `offset` seconds into a `period`.
+ */
+inline unsigned long SimpleCalendar::secondsUntil(
+    unsigned long from, unsigned long period, unsigned long offset
+) {
+    // position within the period, kept non-negative for any offset
+    unsigned long phase = (from % period + period - offset % period) % period;
+    return (period - phase) % period;
+};
+
+/**
+ * Get the delay until the first matching instant, at or after the current
+ * time. Intended for the delay_start of the calendar task.
+ * @param period - The period (in s) of the task, e.g. SIMPLE_CALENDAR_DAY.
+ * @param offset - The offset (in s) of the matching instants into each
+ *     period, e.g., 2 * SIMPLE_CALENDAR_HOUR for "at 02:00" on a daily
+ *     period. For a weekly period, note that Unix time starts on a
+ *     Thursday. Default = 0.
+ * @returns The delay (in ms) until the first matching instant.
+ */
+inline unsigned long SimpleCalendar::untilFirst(
+    unsigned long period, unsigned long offset
+) {
+    return 1000UL * secondsUntil(now(), period, offset);
+};
+
+/**
+ * Get the delay until the next matching instant, after the one being
+ * served. Intended to be returned by the callback of the calendar task.
+ *
+ * NOTE that the instant being served is assumed to be within half a period
+ * of the current time, so that a task run slightly before its instant
+ * (because the `millis()` clock runs fast) is not run twice, and a task run
+ * slightly after its instant is not skipped.
+ *
+ * @param period - The period (in s) of the task.
+ * @param offset - The offset (in s) of the matching instants into each
+ *     period. Default = 0.
+ * @returns The delay (in ms) until the next matching instant.
+ */
+inline unsigned long SimpleCalendar::untilNext(
+    unsigned long period, unsigned long offset
+) {
+    unsigned long half = period / 2;
+    return 1000UL * (half + secondsUntil(now() + half, period, offset));
+};
+
+#endif
@@ -0,0 +1,125 @@
+/**
+ * @file Implement a `SimpleClockCalibration` class that learns how fast the
+ * `millis()` clock runs relative to a reference time source, and converts
+ * nominal durations into `millis()` durations accordingly.
+ *
+ * Micro-controller boards clocked by a ceramic resonator can drift by up to
+ * 0.5%, i.e., several minutes per day. Given timestamps from an accurate
+ * reference (e.g., a real-time clock, GPS, or a time feed from a host),
+ * `SimpleClockCalibration` estimates the drift from the longest available
+ * baseline (the first and the latest reference timestamps), and stores it
+ * as a fixed-point correction factor. The `.scale()` method then corrects
+ * a nominal interval with one multiplication and one shift.
+ *
+ * The (slow) division needed to estimate the drift is only done when a new
+ * reference timestamp is supplied, and `.scale()` is only needed when an
+ * interval is set (e.g., via `.setInterval()` of `SimpleEvents`, or as the
+ * return value of an adaptive schedule), so the calibration adds no cost
+ * to the event loop itself.
+ *
+ * NOTE: all functionalities of the `SimpleClockCalibration` class are
+ * implemented directly in the `simpleCalibration.h` header file. In other
+ * words, there is no separated `.cpp` file.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#ifndef SIMPLE_EVENTS_CALIBRATION_H_
+#define SIMPLE_EVENTS_CALIBRATION_H_
+
+/**
+ * class declaration for the SimpleClockCalibration class.
+ * @param - NO input parameters to the constructor.
+ */
+class SimpleClockCalibration {
+
+  private:
+    // correction factor, in units of 2^-24 (about 0.06 ppm)
+    long correction = 0;
+
+    bool has_origin = false;
+    unsigned long ref_origin = 0;
+    unsigned long local_origin = 0;
+
+  public:
+    void addReference(unsigned long, unsigned long = millis());
+    unsigned long scale(unsigned long);
+    long ppm();
+    void reset();
+};
+
+/**
+ * Supply a timestamp of the reference time source, together with the
+ * `millis()` time at which it is read. The first call sets the origin of
+ * the baseline, and every later call updates the correction factor.
+ *
+ * NOTE that the estimate is only as good as the resolution of the reference
+ * relative to the baseline (e.g., a reference with 1 s resolution over a
+ * 1 hour baseline gives about 300 ppm), and that the baseline must stay
+ * shorter than about 49 days (the range of an unsigned long in ms); call
+ * `.reset()` to start a new baseline.
+ *
+ * @param ref_ms - The reference time (in ms, from any fixed origin).
+ * @param local_ms - The `millis()` time at which ref_ms is read.
+ *     Default = millis().
+ * @returns No explicit return.
+ */
+inline void SimpleClockCalibration::addReference(
+    unsigned long ref_ms, unsigned long local_ms
+) {
+    if (!has_origin){
+        ref_origin = ref_ms;
+        local_origin = local_ms;
+        has_origin = true;
+        return;
+    }
+
+    unsigned long ref_elapsed = ref_ms - ref_origin;
+    unsigned long local_elapsed = local_ms - local_origin;
+
+    if (ref_elapsed == 0) return;
+
+    // (local - ref) / ref, in units of 2^-24: the only division, and it is
+    // done once per reference timestamp rather than once per loop
+    long long diff = (long long) local_elapsed - (long long) ref_elapsed;
+    correction = (long) ((diff * (1LL << 24)) / (long long) ref_elapsed);
+};
+
+/**
+ * Convert a nominal duration (as measured by the reference) into the
+ * corresponding duration of the `millis()` clock.
+ * @param nominal - The nominal duration (in ms).
+ * @returns The corrected duration (in ms of the `millis()` clock).
+ */
+inline unsigned long SimpleClockCalibration::scale(unsigned long nominal){
+
+    // rounded to the nearest ms
+    long long delta = ((long long) nominal * correction + (1LL << 23)) >> 24;
+    return nominal + (unsigned long) delta;
+};
+
+/**
+ * Get the estimated drift of the `millis()` clock.
+ * @param - No input parameter
+ * @returns The drift in parts per million (positive if `millis()` runs
+ *     fast relative to the reference).
+ */
+inline long SimpleClockCalibration::ppm(){
+    return (long) (((long long) correction * 1000000LL) >> 24);
+};
+
+/**
+ * Forget the baseline, but keep the current correction factor until the
+ * second reference timestamp of the new baseline replaces it.
+ * @param - No input parameter
+ * @returns No explicit return.
+ */
+inline void SimpleClockCalibration::reset(){
+    has_origin = false;
+};
+
+#endif
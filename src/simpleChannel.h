@@ -0,0 +1,249 @@
+/**
+ * @file Implement a `SimpleChannel` class, a typed queue of fixed capacity
+ * that carries values from a producer hook to a consumer hook of an event
+ * loop, so that a producer that runs faster than its consumer no longer
+ * overwrites a shared global and loses data.
+ *
+ * When the channel is full, the producer chooses between two policies:
+ *  + `.write()` drops the new value, and counts it as a drop;
+ *  + `.offer()` keeps the channel as it is, and counts a stall, so that the
+ *    producer can hold on to the value and pause itself until there is room
+ *    again (the channel calls the `.onSpace()` callback when that happens,
+ *    which typically resumes the producer).
+ *
+ * Instead of polling the channel in a trigger, the consumer is woken up
+ * directly: when a value is written into an empty channel, the channel calls
+ * the `.onWake()` callback, which typically calls `.wakeReaction()` of
+ * `SimpleEvents` for a consumer reaction that has no trigger. The consumer
+ * then reads everything that is available in one go.
+ *
+ * The queue is meant for a single producer and a single consumer, with the
+ * same lock-free ring as `SimpleSampler` (see `SimpleRing`). The producer may also be an
+ * interrupt service routine, in which case the `.onWake()` callback runs in
+ * the interrupt as well, and so may only call interrupt-safe code such as
+ * `.wakeReaction()` of `SimpleEvents`. The consumer must be main code (e.g.,
+ * a reaction): it briefly turns off interrupts while it takes a value, so
+ * that a value written by an interrupt at the same time cannot slip by
+ * without waking the consumer.
+ *
+ * NOTE: due to the use of template, all functionalities of the
+ * `SimpleChannel` class are implemented directly in the `simpleChannel.h`
+ * header file. In other words, there is no separated `.cpp` file.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#ifndef SIMPLE_EVENTS_CHANNEL_H_
+#define SIMPLE_EVENTS_CHANNEL_H_
+
+#include "simpleRing.h"
+
+// typedef for the wake and space callbacks
+typedef void simpleChannelAction();
+
+/**
+ * class declaration for the SimpleChannel class.
+ * @param - NO input parameters to the constructor. However, template
+ *     parameters that controls the type of the values and the capacity of
+ *     the channel (a power of 2, at most 128) may optionally be supplied.
+ */
+template <typename T = int, int CAP = 8>
+class SimpleChannel {
+
+  private:
+    T values[CAP];
+
+    SimpleRing<CAP> ring;                // slots in use, see SimpleRing
+    volatile unsigned int dropped = 0;   // advanced by the producer only
+    volatile unsigned int stalled = 0;   // advanced by the producer only
+
+    simpleChannelAction * wake_call = nullptr;
+    simpleChannelAction * space_call = nullptr;
+
+    bool push(T);
+
+  public:
+    bool write(T);
+    bool offer(T);
+    bool read(T &);
+    int available();
+    int space();
+    void onWake(simpleChannelAction *);
+    void onSpace(simpleChannelAction *);
+    unsigned int drops();
+    unsigned int stalls();
+    void clearCounts();
+};
+
+/*
+ * Append a value if there is room, and wake the consumer if the channel was
+ * empty. Returns false if the channel is full.
+ */
+template <typename T, int CAP>
+bool SimpleChannel<T, CAP>::push(T value){
+
+    unsigned char count = ring.count();
+
+    if (count >= CAP) return false;
+
+    values[ring.headSlot()] = value;
+    // publish the value only after it is stored
+    ring.publish();
+
+    // callback is last to allow for self-manipulation
+    if ( (count == 0) && (wake_call != nullptr) ) (* wake_call)();
+
+    return true;
+};
+
+/**
+ * Write a value into the channel, or drop it if the channel is full.
+ * Intended to be called by the producer.
+ * @param value - The new value.
+ * @returns true if the value is written, false if it is dropped.
+ */
+template <typename T, int CAP>
+bool SimpleChannel<T, CAP>::write(T value){
+    if (push(value)) return true;
+    dropped++;
+    return false;
+};
+
+/**
+ * Write a value into the channel if there is room, otherwise leave the
+ * channel unchanged so that the producer can try again (e.g., after the
+ * `.onSpace()` callback). Intended to be called by the producer.
+ * @param value - The new value.
+ * @returns true if the value is written, false if the channel is full.
+ */
+template <typename T, int CAP>
+bool SimpleChannel<T, CAP>::offer(T value){
+    if (push(value)) return true;
+    stalled++;
+    return false;
+};
+
+/**
+ * Read the oldest value from the channel. Intended to be called by the
+ * consumer (from the main code, never from an interrupt), typically in a
+ * loop such as `while (channel.read(x)) { ... }`.
+ * @param value - (Reference to) variable that receives the value.
+ * @returns true if a value is read, false if the channel is empty.
+ */
+template <typename T, int CAP>
+bool SimpleChannel<T, CAP>::read(T & value){
+
+    // check and take the value in one go, as seen by an interrupt producer
+    noInterrupts();
+
+    unsigned char count = ring.count();
+
+    if (count == 0){
+        interrupts();
+        return false;
+    }
+
+    value = values[ring.tailSlot()];
+    // free the slot only after the value is copied
+    ring.release();
+
+    interrupts();
+
+    // callback is last to allow for self-manipulation
+    if ( (count == CAP) && (space_call != nullptr) ) (* space_call)();
+
+    return true;
+};
+
+/**
+ * Get the number of values waiting in the channel.
+ * @param - No input parameter
+ * @returns The number of values that can be read.
+ */
+template <typename T, int CAP>
+int SimpleChannel<T, CAP>::available(){
+    return ring.count();
+};
+
+/**
+ * Get the number of values that can be written before the channel is full.
+ * @param - No input parameter
+ * @returns The number of free slots.
+ */
+template <typename T, int CAP>
+int SimpleChannel<T, CAP>::space(){
+    return CAP - available();
+};
+
+/**
+ * Set the function to call when a value is written into an empty channel,
+ * typically to wake the consumer.
+ * @param callback - (Pointer to) function to call.
+ * @returns No explicit return.
+ */
+template <typename T, int CAP>
+void SimpleChannel<T, CAP>::onWake(simpleChannelAction * callback){
+    wake_call = callback;
+};
+
+/**
+ * Set the function to call when a value is read from a full channel,
+ * typically to resume a producer that stalled.
+ * @param callback - (Pointer to) function to call.
+ * @returns No explicit return.
+ */
+template <typename T, int CAP>
+void SimpleChannel<T, CAP>::onSpace(simpleChannelAction * callback){
+    space_call = callback;
+};
+
+/**
+ * Get the number of values dropped by `.write()` since the last
+ * `.clearCounts()`.
+ * @param - No input parameter
+ * @returns The number of dropped values.
+ */
+template <typename T, int CAP>
+unsigned int SimpleChannel<T, CAP>::drops(){
+
+    // counter is wider than a byte: read it with interrupts disabled
+    noInterrupts();
+    unsigned int count = dropped;
+    interrupts();
+    return count;
+};
+
+/**
+ * Get the number of times `.offer()` found the channel full since the last
+ * `.clearCounts()`.
+ * @param - No input parameter
+ * @returns The number of stalls.
+ */
+template <typename T, int CAP>
+unsigned int SimpleChannel<T, CAP>::stalls(){
+
+    noInterrupts();
+    unsigned int count = stalled;
+    interrupts();
+    return count;
+};
+
+/**
+ * Reset the numbers of drops and stalls to 0.
+ * @param - No input parameter
+ * @returns No explicit return.
+ */
+template <typename T, int CAP>
+void SimpleChannel<T, CAP>::clearCounts(){
+
+    noInterrupts();
+    dropped = 0;
+    stalled = 0;
+    interrupts();
+};
+
+#endif
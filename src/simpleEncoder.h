@@ -0,0 +1,193 @@
+/**
+ * @file Implement a `SimpleEncoder` class that decodes a quadrature rotary
+ * encoder and serves as an event source for `SimpleEvents` and `TinyEvents`.
+ *
+ * The encoder pins are sampled by `.update()`, which is intended to be
+ * called from a pin-change interrupt (or from a fast schedule), so that no
+ * step is missed even when the event loop is busy running callbacks. Each
+ * sample is decoded with a table-driven quadrature state machine and the
+ * resulting steps are accumulated in a counter.
+ *
+ * The event loop then consumes the accumulated movement in batches: the
+ * `.available()` method can be used (via a small wrapper function) as the
+ * trigger of a reaction, and the `.read()` method called within the
+ * reaction returns all the detents accumulated since the last read, with
+ * optional rate-based acceleration applied.
+ *
+ * NOTE: all functionalities of the `SimpleEncoder` class are implemented
+ * directly in the `simpleEncoder.h` header file. In other words, there is
+ * no separated `.cpp` file.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#ifndef SIMPLE_EVENTS_ENCODER_H_
+#define SIMPLE_EVENTS_ENCODER_H_
+
+/**
+ * class declaration for the SimpleEncoder class.
+ * @param pin_a - The pin connected to the A (clock) output of the encoder.
+ * @param pin_b - The pin connected to the B (data) output of the encoder.
+ * @param steps_per_detent - The number of quadrature steps between two
+ *     detents (4 for most mechanical encoders). Default = 4.
+ */
+class SimpleEncoder {
+
+  private:
+    uint8_t pin_a;
+    uint8_t pin_b;
+    int8_t steps_per_detent;
+
+    uint8_t accel_max = 1;
+    unsigned long accel_window = 0;
+    unsigned long last_read = 0;
+
+    // the last sampled (A, B) pair is kept in bit 1 and bit 0, so that the
+    // next table index is simply (state << 2) | current
+    volatile uint8_t state = 0;
+    volatile int steps = 0;
+
+  public:
+    SimpleEncoder(uint8_t, uint8_t, int8_t = 4);
+    void begin(uint8_t = INPUT_PULLUP);
+    void update();
+    void update(uint8_t, uint8_t);
+    void setAcceleration(unsigned long, uint8_t);
+    bool available();
+    int read();
+};
+
+/*
+ * Transition table of the quadrature state machine, indexed by
+ * (previous A, previous B, current A, current B). Valid transitions give
+ * +1 or -1, while no change and invalid (bouncing) transitions give 0.
+ */
+static const int8_t simpleEncoderTable[16] = {
+     0, -1,  1,  0,
+     1,  0,  0, -1,
+    -1,  0,  0,  1,
+     0,  1, -1,  0
+};
+
+/**
+ * Constructor of the SimpleEncoder class.
+ * @param pin_a - The pin connected to the A (clock) output of the encoder.
+ * @param pin_b - The pin connected to the B (data) output of the encoder.
+ * @param steps_per_detent - The number of quadrature steps between two
+ *     detents (at least 1; smaller values are taken as 1). Default = 4.
+ */
+inline SimpleEncoder::SimpleEncoder(
+    uint8_t pin_a, uint8_t pin_b, int8_t steps_per_detent
+) : pin_a(pin_a), pin_b(pin_b),
+    steps_per_detent((steps_per_detent > 0) ? steps_per_detent : 1) {};
+
+/**
+ * Set the pin mode of the encoder pins and record their initial state.
+ *
+ * The `.begin()` method should be called ONCE in `setup()`, BEFORE the
+ * interrupt calling `.update()` is attached.
+ *
+ * @param mode - The pin mode of the encoder pins. Default = INPUT_PULLUP.
+ * @returns No explicit return.
+ */
+inline void SimpleEncoder::begin(uint8_t mode){
+
+    pinMode(pin_a, mode);
+    pinMode(pin_b, mode);
+    state = (digitalRead(pin_a) << 1) | digitalRead(pin_b);
+    last_read = millis();
+};
+
+/**
+ * Sample the encoder pins and accumulate any step. Safe to be called from
+ * an interrupt service routine.
+ * @param - No input parameter
+ * @returns No explicit return.
+ */
+inline void SimpleEncoder::update(){
+    update(digitalRead(pin_a), digitalRead(pin_b));
+};
+
+/**
+ * Accumulate any step given the pin levels sampled by the caller (e.g., by
+ * direct port read in an interrupt service routine).
+ * @param a - The level (0 or 1) of the A output of the encoder.
+ * @param b - The level (0 or 1) of the B output of the encoder.
+ * @returns No explicit return.
+ */
+inline void SimpleEncoder::update(uint8_t a, uint8_t b){
+
+    uint8_t next = (state << 2 | a << 1 | b) & 0x0F;
+    steps += simpleEncoderTable[next];
+    state = next;
+};
+
+/**
+ * Set the rate-based acceleration applied by `.read()`. When successive
+ * detents are read less than `window` ms apart, the returned count is
+ * multiplied by a factor that grows linearly up to `max_factor` as the
+ * time between detents shrinks to 0.
+ * @param window - Time (in ms) between detents below which acceleration
+ *     kicks in. Set to 0 to disable acceleration.
+ * @param max_factor - The maximum multiplication factor.
+ * @returns No explicit return.
+ */
+inline void SimpleEncoder::setAcceleration(
+    unsigned long window, uint8_t max_factor
+) {
+    accel_window = window;
+    accel_max = (max_factor < 1) ? 1 : max_factor;
+};
+
+/**
+ * Check whether at least one full detent has been accumulated. Intended to
+ * be wrapped in a trigger function of a reaction.
+ * @param - No input parameter
+ * @returns true if `.read()` would return a non-zero count.
+ */
+inline bool SimpleEncoder::available(){
+
+    noInterrupts();
+    int pending = steps;
+    interrupts();
+    return (pending >= steps_per_detent) || (pending <= -steps_per_detent);
+};
+
+/**
+ * Consume all the full detents accumulated since the last read. Partial
+ * detents are kept for the next read.
+ * @param - No input parameter
+ * @returns The signed number of detents (after acceleration, if enabled).
+ */
+inline int SimpleEncoder::read(){
+
+    int detents;
+
+    // take the whole batch at once so that the ISR never sees a torn count
+    noInterrupts();
+    detents = steps / steps_per_detent;
+    steps -= detents * steps_per_detent;
+    interrupts();
+
+    if (detents == 0) return 0;
+
+    unsigned long now = millis();
+    unsigned long per_detent = (now - last_read) /
+        (unsigned long) ((detents > 0) ? detents : -detents);
+    last_read = now;
+
+    if (per_detent < accel_window){
+        // factor goes from 1 (at window) to accel_max (at 0)
+        detents *= 1 + (int) (
+            (accel_window - per_detent) * (accel_max - 1) / accel_window
+        );
+    }
+
+    return detents;
+};
+
+#endif
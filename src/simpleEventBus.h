@@ -0,0 +1,248 @@
+/**
+ * @file Implement a `SimpleEventBus` class, a publish/subscribe bus for
+ * named events with a small payload (the id of the source, e.g., a pin, and
+ * a value), dispatched from the event loop.
+ *
+ * Topics are small integers fixed at compile time, typically given by an
+ * `enum` in the sketch. Any code may publish an event on a topic, and any
+ * number of handlers may subscribe to a topic. Published events are queued
+ * in a ring of fixed capacity, and delivered to the subscribers when the bus
+ * is drained by `.run()`, typically called in `loop()` right after the
+ * `.run()` of `SimpleEvents`. So a handler never runs inside the code
+ * that published the event, and may itself publish further events, which
+ * are delivered by the next `.run()`.
+ *
+ * The subscribers are kept in a table sorted by topic (in compressed sparse
+ * row form: one array of handlers, and for each topic the index of its first
+ * handler), which is built once in `.begin()`. Delivering an event then
+ * walks a contiguous slice of the table rather than searching it. If the
+ * ring is full, the new event is dropped and counted against its topic.
+ *
+ * NOTE: due to the use of template, all functionalities of the
+ * `SimpleEventBus` class are implemented directly in the `simpleEventBus.h`
+ * header file. In other words, there is no separated `.cpp` file.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#ifndef SIMPLE_EVENTS_BUS_H_
+#define SIMPLE_EVENTS_BUS_H_
+
+#include "simpleRing.h"
+
+// typedef for the handler: receives the topic, the source id, and the value
+typedef void simpleEventBusHandler(unsigned char, unsigned char, int);
+
+/**
+ * class declaration for the SimpleEventBus class.
+ * @param - NO input parameters to the constructor. However, template
+ *     parameters that controls the number of topics, the maximum number of
+ *     subscriptions (over all topics), and the capacity of the ring of
+ *     pending events (a power of 2, at most 128) may optionally be supplied.
+ */
+template <int N_TOPICS = 4, int S_MAX = 8, int Q_CAP = 16>
+class SimpleEventBus {
+
+    static_assert(S_MAX <= 255, "SimpleEventBus: at most 255 subscriptions");
+
+  private:
+    int last_sub = -1;
+    bool is_built = false;
+
+    // subscriptions in the order they are added
+    unsigned char sub_topics[S_MAX] = { 0 };
+    simpleEventBusHandler * sub_calls[S_MAX] = { nullptr };
+
+    // subscriber table: the handlers of topic t are
+    // tbl_calls[tbl_starts[t]] ... tbl_calls[tbl_starts[t + 1] - 1]
+    unsigned char tbl_starts[N_TOPICS + 1] = { 0 };
+    simpleEventBusHandler * tbl_calls[S_MAX] = { nullptr };
+
+    // ring of pending events
+    unsigned char evt_topics[Q_CAP];
+    unsigned char evt_sources[Q_CAP];
+    int evt_values[Q_CAP];
+    SimpleRing<Q_CAP> events;           // slots in use, see SimpleRing
+
+    unsigned int topic_drops[N_TOPICS] = { 0 };
+
+  public:
+    bool subscribe(unsigned char, simpleEventBusHandler *);
+    void begin();
+    bool publish(unsigned char, unsigned char, int);
+    int run(int = Q_CAP);
+    int pending();
+    unsigned int drops(unsigned char);
+    void clearDrops();
+};
+
+/**
+ * Subscribe a handler to a topic. A handler may subscribe to several topics
+ * (it receives the topic as its first argument), and a topic may have
+ * several handlers, which are called in the order they subscribed.
+ * @param topic - The topic, from 0 to N_TOPICS - 1.
+ * @param handler - (Pointer to) function to call with (topic, source,
+ *     value) for each event published on the topic.
+ * @returns true if subscribed, false if the topic is invalid or the maximum
+ *     number of subscriptions is reached.
+ */
+template <int N_TOPICS, int S_MAX, int Q_CAP>
+bool SimpleEventBus<N_TOPICS, S_MAX, Q_CAP>::subscribe(
+    unsigned char topic, simpleEventBusHandler * handler
+) {
+    if ( (topic >= N_TOPICS) || (last_sub >= S_MAX - 1) ) return false;
+
+    last_sub++;
+    sub_topics[last_sub] = topic;
+    sub_calls[last_sub] = handler;
+    is_built = false;
+
+    return true;
+};
+
+/**
+ * Build the subscriber table (a counting sort of the subscriptions by
+ * topic). The `.begin()` method should be called AFTER all handlers have
+ * subscribed; if a handler subscribes later, the table is built again by
+ * the next `.run()`.
+ * @param - No input parameter
+ * @returns No explicit return.
+ */
+template <int N_TOPICS, int S_MAX, int Q_CAP>
+void SimpleEventBus<N_TOPICS, S_MAX, Q_CAP>::begin(){
+
+    unsigned char fill[N_TOPICS];
+    int t, i;
+
+    // count the handlers of each topic...
+    for (t = 0; t <= N_TOPICS; t++) tbl_starts[t] = 0;
+    for (i = 0; i <= last_sub; i++) tbl_starts[sub_topics[i] + 1]++;
+
+    // ...turn the counts into start indices...
+    for (t = 0; t < N_TOPICS; t++){
+        tbl_starts[t + 1] += tbl_starts[t];
+        fill[t] = tbl_starts[t];
+    }
+
+    // ...and place the handlers, keeping their order within each topic
+    for (i = 0; i <= last_sub; i++){
+        tbl_calls[fill[sub_topics[i]]++] = sub_calls[i];
+    }
+
+    is_built = true;
+};
+
+/**
+ * Publish an event on a topic. The event is delivered to the subscribers of
+ * the topic by a later `.run()`.
+ *
+ * NOTE: the ring of pending events is not protected against interrupts, so
+ * events should be published from the main code (e.g., callbacks of the
+ * event loop) rather than from interrupt service routines.
+ *
+ * @param topic - The topic, from 0 to N_TOPICS - 1.
+ * @param source - The id of the source of the event, e.g., a pin number.
+ * @param value - The value carried by the event.
+ * @returns true if queued, false if the topic is invalid or the event is
+ *     dropped because the ring is full.
+ */
+template <int N_TOPICS, int S_MAX, int Q_CAP>
+bool SimpleEventBus<N_TOPICS, S_MAX, Q_CAP>::publish(
+    unsigned char topic, unsigned char source, int value
+) {
+    if (topic >= N_TOPICS) return false;
+
+    if (events.isFull()){
+        topic_drops[topic]++;
+        return false;
+    }
+
+    int slot = events.headSlot();
+    evt_topics[slot] = topic;
+    evt_sources[slot] = source;
+    evt_values[slot] = value;
+    events.publish();
+
+    return true;
+};
+
+/**
+ * Deliver pending events to their subscribers, oldest first. Events that
+ * are published by the handlers are left for the next `.run()`.
+ *
+ * In typical use case, `.run()` is called inside the `loop()` function
+ * right after the `.run()` of `SimpleEvents`, so that the events published
+ * by the hooks are delivered in the same iteration of the loop.
+ *
+ * @param max_events - Largest number of events to deliver in this call, to
+ *     bound the time spent, or a negative number for no limit (other than
+ *     the events pending at the start of the call). Default = Q_CAP.
+ * @returns The number of events delivered.
+ */
+template <int N_TOPICS, int S_MAX, int Q_CAP>
+int SimpleEventBus<N_TOPICS, S_MAX, Q_CAP>::run(int max_events){
+
+    if (!is_built) begin();
+
+    // only the events pending now, so that handlers cannot starve the loop
+    int count = events.count();
+    int n, k, slot, value;
+    unsigned char topic, source;
+
+    if ( (max_events >= 0) && (count > max_events) ) count = max_events;
+
+    for (n = 0; n < count; n++){
+        slot = events.tailSlot();
+        topic = evt_topics[slot];
+        source = evt_sources[slot];
+        value = evt_values[slot];
+        // free the slot first, so that the handlers can publish into it
+        events.release();
+        for (k = tbl_starts[topic]; k < tbl_starts[topic + 1]; k++){
+            (* tbl_calls[k])(topic, source, value);
+        }
+    }
+
+    return count;
+};
+
+/**
+ * Get the number of events waiting to be delivered.
+ * @param - No input parameter
+ * @returns The number of pending events.
+ */
+template <int N_TOPICS, int S_MAX, int Q_CAP>
+int SimpleEventBus<N_TOPICS, S_MAX, Q_CAP>::pending(){
+    return events.count();
+};
+
+/**
+ * Get the number of events dropped on a topic (because the ring was full)
+ * since the last `.clearDrops()`.
+ * @param topic - The topic, from 0 to N_TOPICS - 1.
+ * @returns The number of dropped events, or 0 for an invalid topic.
+ */
+template <int N_TOPICS, int S_MAX, int Q_CAP>
+unsigned int SimpleEventBus<N_TOPICS, S_MAX, Q_CAP>::drops(
+    unsigned char topic
+) {
+    if (topic >= N_TOPICS) return 0;
+    return topic_drops[topic];
+};
+
+/**
+ * Reset the numbers of dropped events of all topics to 0.
+ * @param - No input parameter
+ * @returns No explicit return.
+ */
+template <int N_TOPICS, int S_MAX, int Q_CAP>
+void SimpleEventBus<N_TOPICS, S_MAX, Q_CAP>::clearDrops(){
+    int t;
+    for (t = 0; t < N_TOPICS; t++) topic_drops[t] = 0;
+};
+
+#endif
@@ -32,6 +32,13 @@
 // typedef for various function types
 typedef void simpleEventsAction();
 typedef bool simpleEventsCheck();
+typedef bool simpleEventsAttempt();
+typedef unsigned long simpleEventsAdaptive();
+typedef void simpleEventsTimedAction(unsigned long, unsigned long);
+typedef unsigned long simpleEventsClock();
+typedef void simpleEventsOverload(bool);
+typedef void simpleEventsDeferred(void *);
+typedef void simpleEventsIdle(unsigned long);
 
 /*
  * Allow verbose output via Serial via the SIMPLE_EVENTS_VERBOSE flag.
@@ -47,16 +54,156 @@ typedef bool simpleEventsCheck();
   #define SIMPLE_EVENTS_println(X)
 #endif
 
+/*
+ * Allow the hardware watchdog (AVR only) to guard the callbacks that have a
+ * time budget, via the SIMPLE_EVENTS_WATCHDOG flag, which is set to the
+ * watchdog timeout (e.g., WDTO_500MS) BEFORE including this header.
+ */
+#if defined(SIMPLE_EVENTS_WATCHDOG) && defined(__AVR__)
+  #include <avr/io.h>
+  #include <avr/wdt.h>
+  #define SIMPLE_EVENTS_wdt_enable() (wdt_enable(SIMPLE_EVENTS_WATCHDOG))
+  #define SIMPLE_EVENTS_wdt_reset() (wdt_reset())
+  #define SIMPLE_EVENTS_wdt_disable() (wdt_disable())
+
+/*
+ * After a reset by the watchdog, the watchdog stays armed (with its shortest
+ * timeout, about 15 ms) for as long as the WDRF flag is set, and cannot be
+ * disabled until the flag is cleared. Unless the bootloader clears it, the
+ * board would then be reset over and over, long before setup() runs. So
+ * clear the flag and disable the watchdog right at start-up, in the .init3
+ * section (before the constructors and main()). The code falls through to
+ * the next section, hence `naked`, and each file that includes this header
+ * has its own (harmless) copy, hence `static`.
+ */
+static void simpleEventsWdtOff(void)
+    __attribute__((naked, used, section(".init3")));
+
+static void simpleEventsWdtOff(void){
+    MCUSR &= ~(1 << WDRF);
+    wdt_disable();
+}
+#else
+  #define SIMPLE_EVENTS_wdt_enable()
+  #define SIMPLE_EVENTS_wdt_reset()
+  #define SIMPLE_EVENTS_wdt_disable()
+#endif
+
+/*
+ * Capacity of the queue of deferred actions (see `.defer()`), which is set
+ * by defining SIMPLE_EVENTS_DEFER_MAX (at most 128) BEFORE including this
+ * header. The default of 0 leaves the queue out, so that sketches which do
+ * not defer anything pay no memory for it.
+ */
+#ifndef SIMPLE_EVENTS_DEFER_MAX
+  #define SIMPLE_EVENTS_DEFER_MAX 0
+#endif
+
+// kinds of hook in the fault record
+#define SIMPLE_EVENTS_HOOK_NONE 0
+#define SIMPLE_EVENTS_HOOK_SCHEDULE 1
+#define SIMPLE_EVENTS_HOOK_REACTION 2
+
+// marks a fault record that has been initialized
+#define SIMPLE_EVENTS_FAULT_MAGIC 0x5EFA
+
+// marks a snapshot of the timing state, see `.snapshot()`
+#define SIMPLE_EVENTS_SNAPSHOT_MAGIC 0x5E5A
+
+/*
+ * Fault record of the callbacks with a time budget. On AVR, the record is
+ * kept in the `.noinit` section, so that it survives a reset (e.g., by the
+ * watchdog); on other boards it is cleared on every boot.
+ */
+struct SimpleEventsFault {
+    unsigned int magic;
+    // hook that is running right now (if a reset happens, the culprit)
+    unsigned char running_kind;
+    int running_id;
+    // hook that was running when the board was last reset
+    unsigned char hang_kind;
+    int hang_id;
+    // hook that last exceeded its budget, and the time (in units of the
+    // clock of the event loop) it took
+    unsigned char overrun_kind;
+    int overrun_id;
+    unsigned long overrun_elapsed;
+    // number of budget overruns recorded
+    unsigned int overrun_count;
+};
+
+/**
+ * Get the fault record shared by all instances of `SimpleEvents`.
+ * @param - No input parameter
+ * @returns (Reference to) the fault record.
+ */
+inline SimpleEventsFault & simpleEventsFaults(){
+#ifdef __AVR__
+    static SimpleEventsFault record __attribute__((section(".noinit")));
+#else
+    static SimpleEventsFault record;
+#endif
+    return record;
+};
+
+/*
+ * Time base of the event loop, which turns the raw `millis()` reading into
+ * the timestamp type (Time_t) of the loop. For the default unsigned long the
+ * reading is passed through unchanged (and wraps around after ~49.7 days).
+ */
+template <typename Time_t>
+class SimpleEventsTimeBase {
+  public:
+    Time_t extend(unsigned long raw){ return (Time_t) raw; };
+};
+
+/*
+ * 64-bit time base: the wrap-around of `millis()` is detected lazily, i.e.,
+ * whenever a reading is smaller than the previous one, so the extension
+ * costs one comparison per reading and needs no interrupt. Correct as long
+ * as the clock is read at least once every ~49.7 days.
+ */
+template <>
+class SimpleEventsTimeBase<unsigned long long> {
+  private:
+    unsigned long last_raw = 0;
+    unsigned long long epoch = 0;
+
+  public:
+    unsigned long long extend(unsigned long raw){
+        // the clock wraps at 32 bits, even where unsigned long is wider
+        if (raw < last_raw) epoch += 0x100000000ULL;
+        last_raw = raw;
+        return epoch + raw;
+    };
+};
+
 /**
  * class declaration for the SimpleEvents class.
  * @param - NO input parameters to the constructor. However, template 
  *     parameters that controls the maximum number of event hooks of each
- *     type may optionally be supplied.
+ *     type may optionally be supplied, as well as the type of timestamps
+ *     (unsigned long by default, or unsigned long long for a 64-bit time
+ *     base that never wraps around).
  */ 
-template <int T_MAX = 8, int R_MAX = 8>
+template <int T_MAX = 8, int R_MAX = 8, typename Time_t = unsigned long>
 class SimpleEvents {
 
+    static_assert(T_MAX <= 255, "SimpleEvents: at most 255 schedules");
+
   private:
+    // kinds of schedule, which determine how the callback is invoked
+    enum {
+        SCHD_PLAIN = 0, SCHD_RETRY, SCHD_ADAPTIVE, SCHD_TIMED, SCHD_MONITOR,
+        SCHD_IDLE, SCHD_CHILD
+    };
+
+    // what to do with a child loop, see .runChild()
+    enum { CHILD_QUERY = 0, CHILD_DUE, CHILD_RUN, CHILD_REBASE };
+
+    // acts on a child loop (given as context), returns its next due time
+    typedef Time_t childRunner(void *, unsigned char, Time_t);
+
     int last_schd = -1;
     int last_rct = -1;
     int last_case = -1; 
@@ -65,32 +212,197 @@ class SimpleEvents {
     simpleEventsAction * rct_calls[R_MAX]  = { nullptr };
     simpleEventsCheck  * rct_trigs[R_MAX]  = { nullptr };
 
-    unsigned long schd_tIntrvls[T_MAX] = { 0 };
+    Time_t schd_tIntrvls[T_MAX] = { 0 };
     unsigned long rct_tTimeouts[R_MAX] = { 0 };
     unsigned long rct_tDelays[R_MAX] = { 0 };
 
-    bool schd_areActive[T_MAX] = { false };
-    bool rct_areActive[R_MAX] = { false };
-    bool rct_areTrigged[R_MAX] = { false } ;
+    // kind and state of each hook, packed in a byte
+    struct SchdFlags {
+        unsigned char kind : 3;       // one of the SCHD_ kinds above
+        unsigned char active : 1;
+    };
+    struct RctFlags {
+        unsigned char active : 1;
+        unsigned char trigged : 1;
+        unsigned char timed : 1;      // callback takes time and lateness
+    };
+    SchdFlags schd_flags[T_MAX] = {};
+    RctFlags rct_flags[R_MAX] = {};
+    // retries so far (for monitors: 1 once timed out, until kicked)
+    unsigned char schd_tries[T_MAX] = { 0 };
+    unsigned char schd_maxTries[T_MAX] = { 0 };
+    // context of the hook: the fallback of a retry, or the child loop
+    void * schd_ctxs[T_MAX] = { nullptr };
+    // time budgets, only with the SIMPLE_EVENTS_BUDGETS flag (defined
+    // BEFORE including this header), see .setBudget()
+#ifdef SIMPLE_EVENTS_BUDGETS
+    unsigned long schd_budgets[T_MAX] = { 0 };
+    unsigned long rct_budgets[R_MAX] = { 0 };
+#endif
+
+    // wakes requested by .wakeReaction() (possibly from an interrupt), to
+    // be taken up by the next .run(); kept apart from rct_flags, since an
+    // interrupt must not write to a byte that the main code also writes
+    volatile bool rct_areWoken[R_MAX] = { false };
+    volatile bool any_woken = false;
+
+    Time_t schd_nextCalls[T_MAX] = { 0 };
+
+    // rate groups: schedules with the same interval and phase share a
+    // single deadline check in .run(), see .buildGroups()
+    // (ids fit in a byte, and GRP_END ends the list of members of a group)
+    enum { GRP_END = 0xFF };
+    unsigned char grp_heads[T_MAX] = { 0 };
+    unsigned char schd_grpNexts[T_MAX] = { 0 };
+    int last_grp = -1;
+    Time_t rct_nextTrigs[R_MAX] = { 0 };
+    Time_t rct_nextCalls[R_MAX] = { 0 };
+
+    SimpleEventsTimeBase<Time_t> time_base;
+    simpleEventsClock * clock = millis;
 
-    unsigned long schd_nextCalls[T_MAX] = { 0 };
-    unsigned long rct_nextTrigs[R_MAX] = { 0 };
-    unsigned long rct_nextCalls[R_MAX] = { 0 };
+    // precision mode, only with the SIMPLE_EVENTS_PRECISION flag (defined
+    // BEFORE including this header), see .setPrecision()
+#ifdef SIMPLE_EVENTS_PRECISION
+    Time_t spin_threshold = 0;
+    Time_t max_jitter = 0;
+#endif
+
+    // overload detection, only with the SIMPLE_EVENTS_OVERLOAD flag (defined
+    // BEFORE including this header), see .setOverload()
+#ifdef SIMPLE_EVENTS_OVERLOAD
+    unsigned char schd_crits[T_MAX] = { 0 };
+    Time_t overload_lateness = 0;
+    unsigned char overload_runs = 0;
+    unsigned int recover_runs = 0;
+    unsigned int overload_streak = 0;
+    unsigned char shed_level = 0;
+    bool is_overloaded = false;
+    simpleEventsOverload * overload_call = nullptr;
+#endif
+
+    // FIFO of deferred actions, drained at the end of .run()
+#if SIMPLE_EVENTS_DEFER_MAX > 0
+    simpleEventsAction * dfr_calls[SIMPLE_EVENTS_DEFER_MAX] = { nullptr };
+    void * dfr_ctxs[SIMPLE_EVENTS_DEFER_MAX] = { nullptr };
+    bool dfr_haveCtxs[SIMPLE_EVENTS_DEFER_MAX] = { false };
+    unsigned char dfr_head = 0;
+    unsigned char dfr_limit = SIMPLE_EVENTS_DEFER_MAX;
+#endif
+    unsigned char dfr_count = 0;
+
+    // longest budget given to an idle hook, see .setIdleSlice()
+    Time_t idle_slice = 10;
+
+    // state of the loop as a whole, packed in a byte
+    struct LoopFlags {
+        unsigned char grps_areStale : 1;   // regroup at the next .run()
+        unsigned char has_idle : 1;
+        unsigned char has_child : 1;
+        unsigned char is_begun : 1;
+    };
+    LoopFlags loop_flags = {};
+
+    Time_t tick();
+    void buildGroups();
+#ifdef SIMPLE_EVENTS_PRECISION
+    Time_t spinUntilDue(Time_t);
+#endif
+    void noteJitter(Time_t);
+#ifdef SIMPLE_EVENTS_OVERLOAD
+    void checkOverload(bool);
+#endif
+    bool isShed(int);
+    unsigned long schdBudget(int);
+    unsigned long rctBudget(int);
+    // state of a guarded callback, see .guardStart()
+    struct Guard {
+        Time_t start;
+        unsigned char outer_kind;   // hook running around this one, if any
+        int outer_id;
+    };
+
+    void guardStart(unsigned char, int, Guard &);
+    void guardEnd(unsigned char, int, const Guard &, unsigned long);
+    void callSchedule(int, Time_t);
+    void callReaction(int, Time_t, Time_t);
+    void takeWakes(Time_t);
+    void runDeferred();
+    void runIdle();
+    template <typename Child>
+    static Time_t runChild(void *, unsigned char, Time_t);
+    Time_t childDue(int, unsigned char, Time_t);
+    void skipMissed(int, Time_t, Time_t);
+    static void packBytes(unsigned char *, int &, const void *, int);
+    static void unpackBytes(const unsigned char *, int &, void *, int);
 
   public:
-    int addSchedule(simpleEventsAction *, unsigned long, unsigned long = 0);
+    // size (in bytes) of the largest snapshot, see `.snapshot()`
+    static const int SNAPSHOT_MAX = 4 +
+        T_MAX * (2 * sizeof(Time_t) + 2) + R_MAX * (2 * sizeof(Time_t) + 1);
+
+    int addSchedule(simpleEventsAction *, Time_t, Time_t = 0);
+    int addRetry(
+        simpleEventsAttempt *, simpleEventsAction *,
+        Time_t, unsigned char, Time_t = 0
+    );
+    int addAdaptiveSchedule(
+        simpleEventsAdaptive *, Time_t, Time_t = 0
+    );
+    int addTimedSchedule(
+        simpleEventsTimedAction *, Time_t, Time_t = 0
+    );
+    int addMonitor(simpleEventsAction *, Time_t);
+    int addIdle(simpleEventsIdle *, Time_t);
+    template <typename Child> int addChild(Child &);
     int addReaction(
         simpleEventsCheck *, simpleEventsAction *, 
         unsigned long, unsigned long, unsigned long = 0
     );
+    int addTimedReaction(
+        simpleEventsCheck *, simpleEventsTimedAction *, 
+        unsigned long, unsigned long, unsigned long = 0
+    );
     void pauseSchedule(int);
     void pauseTrigger(int);
     void resumeSchedule(int);
-    void restartSchedule(int, unsigned long, bool = false);
-    void restartTrigger(int, unsigned long, bool = false);
+    void restartSchedule(int, Time_t, bool = false);
+    void setInterval(int, Time_t);
+    bool kick(int);
+    void restartTrigger(int, Time_t, bool = false);
     void stopReaction(int);
-    void cancelReaction(int, unsigned long, bool = false);
-    unsigned long begin();
+    void cancelReaction(int, Time_t, bool = false);
+    void wakeReaction(int);
+    void setClock(simpleEventsClock *);
+#ifdef SIMPLE_EVENTS_PRECISION
+    void setPrecision(Time_t);
+#endif
+    void setIdleSlice(Time_t);
+#ifdef SIMPLE_EVENTS_PRECISION
+    Time_t maxJitter();
+    void resetJitter();
+#endif
+    Time_t nextDue();
+    Time_t nextRun();
+    void rebase(Time_t);
+#ifdef SIMPLE_EVENTS_OVERLOAD
+    void setCriticality(int, unsigned char);
+    void setOverload(
+        Time_t, unsigned char, unsigned char = 1, unsigned int = 0
+    );
+    void onOverload(simpleEventsOverload *);
+    bool isOverloaded();
+#endif
+#ifdef SIMPLE_EVENTS_BUDGETS
+    void setBudget(int, unsigned long);
+    void setReactionBudget(int, unsigned long);
+#endif
+    bool defer(simpleEventsAction *);
+    bool defer(simpleEventsDeferred *, void *);
+    void setDeferLimit(unsigned char);
+    Time_t begin();
+    int snapshot(unsigned char *, int);
+    bool restore(const unsigned char *, int, Time_t);
     void run();
 };
 
@@ -102,10 +414,10 @@ class SimpleEvents {
  *     time the callback is called.
  * @returns The id (= array index) of the schedule.
  */
-template <int T_MAX, int R_MAX>
-int SimpleEvents<T_MAX, R_MAX>::addSchedule(
+template <int T_MAX, int R_MAX, typename Time_t>
+int SimpleEvents<T_MAX, R_MAX, Time_t>::addSchedule(
     simpleEventsAction * callback, 
-    unsigned long interval, unsigned long delay_start
+    Time_t interval, Time_t delay_start
 ) {
     if (last_schd > T_MAX - 2){ 
         // failure: no more task can be added
@@ -115,18 +427,219 @@ int SimpleEvents<T_MAX, R_MAX>::addSchedule(
     schd_calls[++last_schd] = callback;
     schd_tIntrvls[last_schd] = interval;
     schd_nextCalls[last_schd] = delay_start;
-    schd_areActive[last_schd] = true;
+    schd_flags[last_schd].active = true;
     SIMPLE_EVENTS_print("Schedule #");
     SIMPLE_EVENTS_print(last_schd);
     SIMPLE_EVENTS_println(" added");
     return last_schd;
 };
 
+/**
+ * Add a new retry schedule to the event loop. The attempt callback is
+ * called at .begin() + delay_start. If it fails (returns false), it is
+ * called again after an exponentially increasing delay (base_delay, then
+ * 2 * base_delay, 4 * base_delay, ..., each with a random jitter of up to
+ * 25%), until it succeeds or max_attempts attempts have failed, in which
+ * case on_fail is called. Either way, the retry schedule is then paused,
+ * and .restartSchedule() starts a new series of attempts.
+ * @param attempt - (Pointer to) function to attempt, which returns true on
+ *     success and false on failure.
+ * @param on_fail - (Pointer to) function to callback when all attempts
+ *     have failed. May be nullptr.
+ * @param base_delay - Time (in ms) between the first failure and the
+ *     second attempt. The delay doubles after each failed attempt, up to
+ *     32768 * base_delay.
+ * @param max_attempts - The maximum number of attempts in a series.
+ * @param delay_start - Time delay (in ms) between .begin() and the first 
+ *     attempt. Default = 0.
+ * @returns The id (= array index) of the schedule.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+int SimpleEvents<T_MAX, R_MAX, Time_t>::addRetry(
+    simpleEventsAttempt * attempt, simpleEventsAction * on_fail,
+    Time_t base_delay, unsigned char max_attempts,
+    Time_t delay_start
+) {
+    // a retry is a schedule whose deadline is re-armed by the loop
+    int schd_id = addSchedule(
+        (simpleEventsAction *) attempt, base_delay, delay_start
+    );
+    if (schd_id < 0) return -1;
+
+    schd_flags[schd_id].kind = SCHD_RETRY;
+    schd_ctxs[schd_id] = (void *) on_fail;
+    schd_maxTries[schd_id] = (max_attempts < 1) ? 1 : max_attempts;
+    return schd_id;
+};
+
+/** 
+ * Add a new self-adjusting schedule to the event loop. Same as
+ * .addSchedule(), except that the callback returns the interval (in ms)
+ * until its next call, or 0 to keep the current interval. The new interval
+ * counts from the time the call was due, so the "ticks" of the schedule
+ * stay in phase.
+ * @param callback - (Pointer to) function to callback at scheduled times,
+ *     which returns the next interval (or 0 for no change).
+ * @param interval - Initial time (in ms) interval between successive run of
+ *     callback.
+ * @param delay_start - Time delay (in ms) between .begin() and the first 
+ *     time the callback is called.
+ * @returns The id (= array index) of the schedule.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+int SimpleEvents<T_MAX, R_MAX, Time_t>::addAdaptiveSchedule(
+    simpleEventsAdaptive * callback,
+    Time_t interval, Time_t delay_start
+) {
+    int schd_id = addSchedule(
+        (simpleEventsAction *) callback, interval, delay_start
+    );
+    if (schd_id < 0) return -1;
+
+    schd_flags[schd_id].kind = SCHD_ADAPTIVE;
+    return schd_id;
+};
+
+/** 
+ * Add a new timed schedule to the event loop. Same as .addSchedule(),
+ * except that the callback receives the time of the current loop (as
+ * returned by millis() at the start of .run()) and the lateness of the
+ * call (i.e., the time elapsed since the call was due), so that it need
+ * not read the clock again to compensate for jitter.
+ * @param callback - (Pointer to) function to callback at scheduled times,
+ *     with arguments (now, lateness).
+ * @param interval - Time (in ms) interval between successive run of callback.
+ * @param delay_start - Time delay (in ms) between .begin() and the first 
+ *     time the callback is called.
+ * @returns The id (= array index) of the schedule.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+int SimpleEvents<T_MAX, R_MAX, Time_t>::addTimedSchedule(
+    simpleEventsTimedAction * callback,
+    Time_t interval, Time_t delay_start
+) {
+    int schd_id = addSchedule(
+        (simpleEventsAction *) callback, interval, delay_start
+    );
+    if (schd_id < 0) return -1;
+
+    schd_flags[schd_id].kind = SCHD_TIMED;
+    return schd_id;
+};
+
+/**
+ * Add a new liveness monitor to the event loop. A monitor is a schedule
+ * that runs its callback only if it is not kicked (via `.kick()`) within
+ * `window` of .begin() or of the last kick, and then only once until the
+ * next kick. Since a kick just moves the single deadline of the monitor,
+ * there is no polling of timestamps.
+ * @param on_timeout - (Pointer to) function to callback when the window
+ *     passes without a kick.
+ * @param window - Longest time (in ms) allowed between kicks.
+ * @returns The id (= array index) of the monitor, which is also a schedule
+ *     id (e.g., for `.pauseSchedule()`).
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+int SimpleEvents<T_MAX, R_MAX, Time_t>::addMonitor(
+    simpleEventsAction * on_timeout, Time_t window
+) {
+    int schd_id = addSchedule(on_timeout, window, window);
+    if (schd_id < 0) return -1;
+
+    schd_flags[schd_id].kind = SCHD_MONITOR;
+    return schd_id;
+};
+
+/**
+ * Add a new idle hook to the event loop, for housekeeping work (e.g.,
+ * statistics, or flushing a log) that should only run when the loop has
+ * time to spare. At the end of each `.run()`, the callback is called if the
+ * time until the next deadline (see `.nextDue()`) is longer than
+ * `threshold`, and is given that time as its budget (but at most the
+ * slice set by `.setIdleSlice()`), so that it can size its work to finish
+ * before the next hook is due.
+ * @param callback - (Pointer to) function to callback, which takes the
+ *     time budget (in units of the clock, i.e., ms by default) as input.
+ * @param threshold - Shortest time (in ms) until the next deadline for
+ *     the callback to be called.
+ * @returns The id (= array index) of the idle hook, which is also a
+ *     schedule id (e.g., for `.pauseSchedule()` and `.setBudget()`).
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+int SimpleEvents<T_MAX, R_MAX, Time_t>::addIdle(
+    simpleEventsIdle * callback, Time_t threshold
+) {
+    int schd_id = addSchedule((simpleEventsAction *) callback, threshold);
+    if (schd_id < 0) return -1;
+
+    schd_flags[schd_id].kind = SCHD_IDLE;
+    loop_flags.has_idle = true;
+    return schd_id;
+};
+
+/**
+ * Add another event loop (the child), e.g., the loop of a module of the
+ * sketch, as a hook of this event loop (the parent). The parent runs the
+ * child only when the child has something to do (see `.nextRun()` of the
+ * child, which is asked again in every `.run()`), rather than in every
+ * loop. Pausing the hook (via `.pauseSchedule()`) pauses everything in the
+ * child at once, and resuming it rebases the child (see `.rebase()`).
+ *
+ * NOTE that the child must use the same clock as the parent, and its
+ * `.begin()` should be called BEFORE the `.begin()` of the parent.
+ *
+ * @param child - (Reference to) the child event loop, an instance of
+ *     `SimpleEvents` (of any size).
+ * @returns The id (= array index) of the hook, which is also a schedule id
+ *     (e.g., for `.pauseSchedule()`).
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+template <typename Child>
+int SimpleEvents<T_MAX, R_MAX, Time_t>::addChild(Child & child){
+
+    childRunner * runner = runChild<Child>;
+    int schd_id = addSchedule((simpleEventsAction *) runner, 0);
+    if (schd_id < 0) return -1;
+
+    schd_flags[schd_id].kind = SCHD_CHILD;
+    schd_ctxs[schd_id] = (void *) &child;
+    loop_flags.has_child = true;
+    return schd_id;
+};
+
+/**
+ * Kick a liveness monitor identified by its id, i.e., report that the
+ * monitored activity is alive. The monitor times out one window after the
+ * (latest) kick, and is re-armed if it has already timed out. A monitor
+ * that is paused (via `.pauseSchedule()`) stays paused. Before `.begin()`,
+ * a kick has no effect, since the first window starts at `.begin()`.
+ *
+ * NOTE: call from the main code (e.g., a reaction or the `loop()`) rather
+ * than from an interrupt, since the deadline is wider than a single byte.
+ *
+ * @param schd_id - The id of the monitor.
+ * @returns true if kicked, false if the id is not that of a monitor.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+bool SimpleEvents<T_MAX, R_MAX, Time_t>::kick(int schd_id){
+
+    if ( (schd_id < 0) || (schd_id > last_schd) ) return false;
+    if (schd_flags[schd_id].kind != SCHD_MONITOR) return false;
+
+    // monitors are never grouped, so the groups need no rebuild
+    if (loop_flags.is_begun) schd_nextCalls[schd_id] = tick() + schd_tIntrvls[schd_id];
+    schd_tries[schd_id] = 0;
+
+    return true;
+};
+
 /**
  * Add a new reaction (code to execute on trigger) and its corresponding 
  * trigger to the event loop.
  * @param trigger - The check to perform every loop, in the form of (pointer
- *     to) a function that returns true if the callback is to be triggered.
+ *     to) a function that returns true if the callback is to be triggered,
+ *     or nullptr for a reaction that only runs when woken by
+ *     `.wakeReaction()`.
  * @param callback - (Pointer to) function to callback if the reaction is 
  *     triggered.
  * @param timeout - Timeout (in ms) on trigger after the callback is scheduled.
@@ -138,8 +651,8 @@ int SimpleEvents<T_MAX, R_MAX>::addSchedule(
  *     time the trigger is checked. Default = 0.
  * @returns The id (= array index) of the trigger/reaction pair.
  */
-template <int T_MAX, int R_MAX>
-int SimpleEvents<T_MAX, R_MAX>::addReaction(
+template <int T_MAX, int R_MAX, typename Time_t>
+int SimpleEvents<T_MAX, R_MAX, Time_t>::addReaction(
     simpleEventsCheck * trigger, simpleEventsAction * callback,
     unsigned long timeout, unsigned long delay, unsigned long delay_start
 ) {
@@ -154,7 +667,8 @@ int SimpleEvents<T_MAX, R_MAX>::addReaction(
     rct_tTimeouts[last_rct] = timeout;
     rct_tDelays[last_rct] = delay;
     rct_nextTrigs[last_rct] = delay_start;
-    rct_areActive[last_rct] = true;
+    // a reaction without trigger is never checked, only woken
+    rct_flags[last_rct].active = (trigger != nullptr);
 
     SIMPLE_EVENTS_print("Reaction #");
     SIMPLE_EVENTS_print(last_rct);
@@ -162,17 +676,50 @@ int SimpleEvents<T_MAX, R_MAX>::addReaction(
     return last_rct;
 };
 
+/**
+ * Add a new timed reaction and its corresponding trigger to the event loop.
+ * Same as .addReaction(), except that the callback receives the time of
+ * the current loop (as returned by millis() at the start of .run()) and
+ * the lateness of the call (i.e., the time elapsed since the end of the
+ * delay, which is 0 for immediate reactions).
+ * @param trigger - The check to perform every loop, in the form of (pointer
+ *     to) a function that returns true if the callback is to be triggered,
+ *     or nullptr for a reaction that only runs when woken by
+ *     `.wakeReaction()`.
+ * @param callback - (Pointer to) function to callback if the reaction is 
+ *     triggered, with arguments (now, lateness).
+ * @param timeout - Timeout (in ms) on trigger after the callback is scheduled.
+ * @param delay - The delay (in ms) between the triggering of the reaction and
+ *     the execution of the corresponding callback.
+ * @param delay_start - Time delay (in ms) between .begin() and the first 
+ *     time the trigger is checked. Default = 0.
+ * @returns The id (= array index) of the trigger/reaction pair.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+int SimpleEvents<T_MAX, R_MAX, Time_t>::addTimedReaction(
+    simpleEventsCheck * trigger, simpleEventsTimedAction * callback,
+    unsigned long timeout, unsigned long delay, unsigned long delay_start
+) {
+    int rct_id = addReaction(
+        trigger, (simpleEventsAction *) callback, timeout, delay, delay_start
+    );
+    if (rct_id < 0) return -1;
+
+    rct_flags[rct_id].timed = true;
+    return rct_id;
+};
+
 /**
  * Pause the execution of a specific scheduled task identified by its id.
  * @param schd_id - The id of the scheduled task.
  * @returns No explicit return.
  */
-template <int T_MAX, int R_MAX>
-void SimpleEvents<T_MAX, R_MAX>::pauseSchedule(int schd_id){
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::pauseSchedule(int schd_id){
 
     if ( (schd_id < 0) || (schd_id > last_schd) ) return;
 
-    schd_areActive[schd_id] = false;
+    schd_flags[schd_id].active = false;
     SIMPLE_EVENTS_print("Schedule #");
     SIMPLE_EVENTS_print(schd_id);
     SIMPLE_EVENTS_println(" paused");
@@ -186,12 +733,12 @@ void SimpleEvents<T_MAX, R_MAX>::pauseSchedule(int schd_id){
  * NOTE that any pending reaction already triggered will still run unless
  * the corresponding cancelReaction() is also called.
  */
-template <int T_MAX, int R_MAX>
-void SimpleEvents<T_MAX, R_MAX>::pauseTrigger(int rct_id){
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::pauseTrigger(int rct_id){
 
     if ( (rct_id < 0) || (rct_id > last_rct) ) return;
 
-    rct_areActive[rct_id] = false;
+    rct_flags[rct_id].active = false;
     SIMPLE_EVENTS_print("Trigger #");
     SIMPLE_EVENTS_print(rct_id);
     SIMPLE_EVENTS_println(" paused");
@@ -204,12 +751,20 @@ void SimpleEvents<T_MAX, R_MAX>::pauseTrigger(int rct_id){
  * @param schd_id - The id of the scheduled task.
  * @returns No explicit return.
  */
-template <int T_MAX, int R_MAX>
-void SimpleEvents<T_MAX, R_MAX>::resumeSchedule(int schd_id) {
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::resumeSchedule(int schd_id) {
 
     if ( (schd_id < 0) || (schd_id > last_schd) ) return;
 
-    schd_areActive[schd_id] = true;
+    // a child loop kept its own clock while paused: skip what it missed
+    if (
+        loop_flags.is_begun && !schd_flags[schd_id].active &&
+        (schd_flags[schd_id].kind == SCHD_CHILD)
+    ) {
+        schd_nextCalls[schd_id] = childDue(schd_id, CHILD_REBASE, tick());
+    }
+
+    schd_flags[schd_id].active = true;
     SIMPLE_EVENTS_print("Schedule #");
     SIMPLE_EVENTS_print(schd_id);
     SIMPLE_EVENTS_println(" resumed");
@@ -218,29 +773,53 @@ void SimpleEvents<T_MAX, R_MAX>::resumeSchedule(int schd_id) {
 /**
  * Restart the execution of a specific scheduled task identified by its id.
  * The "ticks" of the clock of the schedule is reset (see .resumeSchedule()
- * for the alternative).
+ * for the alternative). For a retry schedule, a new series of attempts is
+ * started.
  * @param schd_id - The id of the scheduled task.
  * @param timestamp - The time from which the scheduled task is run again.
  * @param abs - if false, the timestamp is relative to current time,
  *     otherwise it is the absolute time 
  * @returns No explicit return.
  */
-template <int T_MAX, int R_MAX>
-void SimpleEvents<T_MAX, R_MAX>::restartSchedule(
-    int schd_id, unsigned long timestamp, bool abs
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::restartSchedule(
+    int schd_id, Time_t timestamp, bool abs
 ) {
 
     if ( (schd_id < 0) || (schd_id > last_schd) ) return;
 
-    if (!abs) timestamp += millis();
+    if (!abs) timestamp += tick();
 
-    schd_areActive[schd_id] = true;
+    schd_flags[schd_id].active = true;
     schd_nextCalls[schd_id] = timestamp;
+    loop_flags.grps_areStale = true;
+    schd_tries[schd_id] = 0;
     SIMPLE_EVENTS_print("Schedule #");
     SIMPLE_EVENTS_print(schd_id);
     SIMPLE_EVENTS_println(" restarted");
 };
 
+/**
+ * Change the interval of a specific scheduled task identified by its id.
+ * The pending deadline is moved in place, so that the next call comes one
+ * new interval after the last "tick" of the schedule (which stays in phase).
+ * @param schd_id - The id of the scheduled task.
+ * @param interval - The new time (in ms) interval between successive run of
+ *     the callback.
+ * @returns No explicit return.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::setInterval(
+    int schd_id, Time_t interval
+) {
+
+    if ( (schd_id < 0) || (schd_id > last_schd) ) return;
+
+    schd_nextCalls[schd_id] += interval - schd_tIntrvls[schd_id];
+    schd_tIntrvls[schd_id] = interval;
+    loop_flags.grps_areStale = true;
+};
+
 /**
  * Restart the trigger check of a specific reaction identified by its id.
  * @param rct_id - The id of the reaction.
@@ -249,17 +828,17 @@ void SimpleEvents<T_MAX, R_MAX>::restartSchedule(
  *     otherwise it is the absolute time 
  * @returns No explicit return.
  */
-template <int T_MAX, int R_MAX>
-void SimpleEvents<T_MAX, R_MAX>::restartTrigger(
-    int rct_id, unsigned long timestamp, bool abs
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::restartTrigger(
+    int rct_id, Time_t timestamp, bool abs
 ) {
 
     if ( (rct_id < 0) || (rct_id > last_rct) ) return;
 
-    if (!abs) timestamp += millis();
+    if (!abs) timestamp += tick();
 
     rct_nextTrigs[rct_id] = timestamp;
-    rct_areActive[rct_id] = true;
+    rct_flags[rct_id].active = (rct_trigs[rct_id] != nullptr);
     SIMPLE_EVENTS_print("Trigger #");
     SIMPLE_EVENTS_print(rct_id);
     SIMPLE_EVENTS_println(" restarted");
@@ -275,17 +854,17 @@ void SimpleEvents<T_MAX, R_MAX>::restartTrigger(
  *     otherwise it is the absolute time 
  * @returns No explicit return.
  */
-template <int T_MAX, int R_MAX>
-void SimpleEvents<T_MAX, R_MAX>::cancelReaction(
-  int rct_id, unsigned long timestamp, bool abs
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::cancelReaction(
+  int rct_id, Time_t timestamp, bool abs
 ) {
 
     if ( (rct_id < 0) || (rct_id > last_rct) ) return;
 
-    if (!abs) timestamp += millis();
+    if (!abs) timestamp += tick();
     rct_nextTrigs[rct_id] = timestamp;
 
-    rct_areTrigged[rct_id] = false;
+    rct_flags[rct_id].trigged = false;
     SIMPLE_EVENTS_print("Reaction #");
     SIMPLE_EVENTS_print(rct_id);
     SIMPLE_EVENTS_println(" canceled");
@@ -298,115 +877,1296 @@ void SimpleEvents<T_MAX, R_MAX>::cancelReaction(
  * @param rct_id - The id of the reaction.
  * @returns No explicit return.
  */
-template <int T_MAX, int R_MAX>
-void SimpleEvents<T_MAX, R_MAX>::stopReaction(int rct_id) {
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::stopReaction(int rct_id) {
 
     if ( (rct_id < 0) || (rct_id > last_rct) ) return;
 
-    rct_areTrigged[rct_id] = false;
+    rct_flags[rct_id].trigged = false;
     SIMPLE_EVENTS_print("Reaction #");
     SIMPLE_EVENTS_print(rct_id);
     SIMPLE_EVENTS_println(" stopped");
 };
 
 /**
- * Set the timers for all scheduled tasks and reactions.
- * 
- * The `.begin()` method should be called ONCE, AFTER all event hooks are
- * added (via `addSchedule()` and `addReaction()`), but BEFORE the `.run()`
- * method is ever called.
+ * Wake a specific reaction identified by its id, i.e., register it as
+ * triggered without checking its trigger, so that its callback runs after
+ * its delay (or, for a reaction without delay, at the next `.run()`, or
+ * later in the current `.run()` if woken by a schedule). The wake is only
+ * noted here, and taken up by `.run()`, which also starts the delay; a
+ * reaction that is already pending by then is left as it is. Intended for
+ * consumers of data (see `SimpleChannel`), which can then be added with a
+ * nullptr trigger instead of being polled.
  *
- * In arduino the `.begin()` method is generally expected to be called 
- * within the `setup()` function.
+ * NOTE: unlike the other methods, `.wakeReaction()` may be called from an
+ * interrupt service routine.
+ *
+ * @param rct_id - The id of the reaction.
+ * @returns No explicit return.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::wakeReaction(int rct_id){
+
+    if ( (rct_id < 0) || (rct_id > last_rct) ) return;
+
+    // single-byte writes, so no need to turn off interrupts
+    rct_areWoken[rct_id] = true;
+    any_woken = true;
+};
+
+/**
+ * Replace the clock of the event loop, e.g., by `micros` for schedules with
+ * sub-millisecond resolution. All times (intervals, delays, timeouts, the
+ * timestamps given to and returned by the methods, and the time and lateness
+ * passed to timed callbacks) are then in units of the new clock.
+ *
+ * NOTE that this method must be called BEFORE `.begin()`. Also note that
+ * `micros()` wraps around after about 71.6 minutes; for sketches that run
+ * longer, use the 64-bit time base (third template parameter).
+ *
+ * @param clock - (Pointer to) function that returns the current time, such
+ *     as `millis` (the default) or `micros`.
+ * @returns No explicit return.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::setClock(simpleEventsClock * clock){
+    this->clock = clock;
+};
+
+#ifdef SIMPLE_EVENTS_PRECISION
+
+/**
+ * Turn on (or off) the precision mode of the event loop. In precision mode,
+ * if the next scheduled task or pending reaction is due within
+ * `spin_threshold` of the start of `.run()`, then `.run()` busy-waits until
+ * the exact instant it is due instead of returning to `loop()`. Since the
+ * wait never exceeds `spin_threshold`, other hooks (and the rest of `loop()`)
+ * are delayed by at most that much.
+ *
+ * The precision mode is intended for use with the `micros` clock (see
+ * `.setClock()`), with a threshold somewhat longer than the longest pass
+ * through `loop()`, e.g., a few hundred microseconds.
  *
+ * NOTE: the precision mode (and so this method, `.maxJitter()`, and
+ * `.resetJitter()`) is only available if the SIMPLE_EVENTS_PRECISION flag is
+ * defined BEFORE including this header.
+ *
+ * @param spin_threshold - Longest time (in units of the clock) that `.run()`
+ *     may busy-wait for a deadline. Set to 0 to turn the precision mode off.
+ * @returns No explicit return.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::setPrecision(Time_t spin_threshold){
+    this->spin_threshold = spin_threshold;
+};
+
+#endif
+
+/**
+ * Set the longest budget given to an idle hook (see `.addIdle()`) in one
+ * call. The time until the next deadline can be very long (or unbounded,
+ * e.g., when only reactions are registered, since their triggers have no
+ * deadline), while the triggers are still checked only between the calls
+ * of the idle hooks; the slice bounds how long an idle hook may hold them
+ * up.
+ * @param idle_slice - Longest budget (in units of the clock, at least 1).
+ *     Default (if the method is never called) = 10.
+ * @returns No explicit return.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::setIdleSlice(Time_t idle_slice){
+    this->idle_slice = (idle_slice > 0) ? idle_slice : 1;
+};
+
+#ifdef SIMPLE_EVENTS_PRECISION
+
+/**
+ * Get the worst lateness of the scheduled tasks and pending reactions
+ * executed in precision mode, since the last `.resetJitter()`. Note that a
+ * hook runs at the earliest one clock unit after its deadline, since a
+ * deadline counts as passed only once the clock moves beyond it.
  * @param - No input parameter
- * @returns the timestamp at which the internal "clock tick" started
+ * @returns The worst lateness (in units of the clock).
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+Time_t SimpleEvents<T_MAX, R_MAX, Time_t>::maxJitter(){
+    return max_jitter;
+};
+
+/**
+ * Reset the worst lateness reported by `.maxJitter()`.
+ * @param - No input parameter
+ * @returns No explicit return.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::resetJitter(){
+    max_jitter = 0;
+};
+
+#endif
+
+/**
+ * Get the earliest deadline of the active schedules and of the reactions
+ * that are triggered and waiting for their delay, e.g., to decide how long
+ * the board may sleep. Triggers that are yet to fire are not deadlines, and
+ * are not taken into account.
+ * @param - No input parameter
+ * @returns The timestamp (in units of the clock) at which the next hook is
+ *     due, which may be in the past if a hook is late, or the largest value
+ *     of Time_t if no hook is waiting.
  */
-template <int T_MAX, int R_MAX>
-unsigned long SimpleEvents<T_MAX, R_MAX>::begin(){
+template <int T_MAX, int R_MAX, typename Time_t>
+Time_t SimpleEvents<T_MAX, R_MAX, Time_t>::nextDue(){
 
-    unsigned long now = millis(); // note that there is a common reference time
+    Time_t due = ~((Time_t) 0);
+    Time_t child_due;
     int i;
 
+    // a reaction woken but not yet registered: due right away
+    if (any_woken) return 0;
+
     for (i = 0; i <= last_schd; i++){
-        schd_nextCalls[i] += now;
+        // the deadline of a child loop may have moved since the last run
+        if (schd_flags[i].active && (schd_flags[i].kind == SCHD_CHILD)){
+            child_due = (* (childRunner *) schd_calls[i])(
+                schd_ctxs[i], CHILD_DUE, 0
+            );
+            if (child_due < due) due = child_due;
+            continue;
+        }
+        if (
+            schd_flags[i].active && (schd_flags[i].kind != SCHD_IDLE) &&
+            !( (schd_flags[i].kind == SCHD_MONITOR) && (schd_tries[i] > 0) ) &&
+            (schd_nextCalls[i] < due)
+        ) {
+            due = schd_nextCalls[i];
+        }
     }
 
     for (i = 0; i <= last_rct; i++){
-        rct_nextTrigs[i] += now;
+        if (rct_flags[i].trigged && (rct_nextCalls[i] < due)){
+            due = rct_nextCalls[i];
+        }
     }
 
-    SIMPLE_EVENTS_print("SimpleEvents clock start ticking at millis() = ");
-    SIMPLE_EVENTS_println(now);
-
-    return now;
-
+    return due;
 };
 
 /**
- * Execute any overdue scheduled tasks and reactions, then check and register
- * any overdue triggers.
- * 
- * In arduino the `.run()` method is intended to be used inside the 
- * `loop()` function so as to create an event LOOP.
- * 
+ * Get the earliest time at which `.run()` has something to do, i.e., the
+ * earliest of `.nextDue()`, the time from which the triggers of the active
+ * reactions are checked (usually in the past, since a trigger is checked in
+ * every loop), and right away if there are deferred actions. This is what
+ * a parent loop uses to decide when to run a child loop (see
+ * `.addChild()`).
  * @param - No input parameter
- * @returns No explicit return.
+ * @returns The timestamp (in units of the clock) at which `.run()` next has
+ *     something to do, or the largest value of Time_t if nothing.
  */
-template <int T_MAX, int R_MAX>
-void SimpleEvents<T_MAX, R_MAX>::run(){
+template <int T_MAX, int R_MAX, typename Time_t>
+Time_t SimpleEvents<T_MAX, R_MAX, Time_t>::nextRun(){
+
+    Time_t due = nextDue();
+    Time_t child_run;
+    int i;
 
-    unsigned long now = millis(); // again, a common reference time for all actions
-    int i, k;
+    // deferred actions: due right away
+    if (dfr_count > 0) return 0;
 
-    // first execute scheduled (periodic) tasks
+    // a child loop may need running before its deadline, e.g., to check
+    // its triggers
     for (i = 0; i <= last_schd; i++){
-        if (schd_nextCalls[i] < now){
-            // no `now`: keep the "ticks" synchronized with the initial tick
-            // always keep the clock ticking regardless of whether task active
-            schd_nextCalls[i] += schd_tIntrvls[i];
-            if (schd_areActive[i]){
-                // callback only if the task is active
-                // callback is last to allow for self-manipulation
-                (* schd_calls[i])();
-                SIMPLE_EVENTS_print("Schedule #");
-                SIMPLE_EVENTS_print(i);
-                SIMPLE_EVENTS_println(" executed");
-            }
+        if (schd_flags[i].active && (schd_flags[i].kind == SCHD_CHILD)){
+            child_run = (* (childRunner *) schd_calls[i])(
+                schd_ctxs[i], CHILD_QUERY, 0
+            );
+            if (child_run < due) due = child_run;
         }
     }
 
-    // then execute pending reactions that are already triggered
     for (i = 0; i <= last_rct; i++){
-        if (rct_areTrigged[i] && (rct_nextCalls[i] < now)){
-            rct_areTrigged[i] = false;
-            // callback is last to allow for self-manipulation
-            (* rct_calls[i])();
-            SIMPLE_EVENTS_print("Reaction #");
-            SIMPLE_EVENTS_print(i);
-            SIMPLE_EVENTS_println(" executed");
+        if (rct_flags[i].active && (rct_nextTrigs[i] < due)){
+            due = rct_nextTrigs[i];
         }
     }
 
-    // then check for any new trigger for reactions
-    for (i = 0; i <= last_rct; i++){
-        if (
-            rct_areActive[i] && (rct_nextTrigs[i] < now) &&
-            (* rct_trigs[i])()
-        ) {
-            if (rct_tDelays[i] == 0){
-                // if reaction is immediate, directly execute it
-                rct_nextTrigs[i] = now + rct_tTimeouts[i];
-                // callback is last to allow for self-manipulation
-                (* rct_calls[i])();
-                SIMPLE_EVENTS_print("Reaction #");
-                SIMPLE_EVENTS_print(i);
-                SIMPLE_EVENTS_println(" triggered and executed");
-            } else {
-                // else register it to run
-                rct_nextTrigs[i] = now + rct_tTimeouts[i];
+    return due;
+};
+
+#ifdef SIMPLE_EVENTS_OVERLOAD
+
+/**
+ * Set the criticality level of a specific scheduled task identified by its
+ * id. While the event loop is overloaded (see `.setOverload()`), scheduled
+ * tasks with a criticality level below the shedding level are skipped.
+ *
+ * NOTE: the overload detection (and so this method, `.setOverload()`,
+ * `.onOverload()`, and `.isOverloaded()`) is only available if the
+ * SIMPLE_EVENTS_OVERLOAD flag is defined BEFORE including this header.
+ *
+ * @param schd_id - The id of the scheduled task.
+ * @param level - The criticality level, higher is more critical. All
+ *     scheduled tasks start with level 0.
+ * @returns No explicit return.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::setCriticality(
+    int schd_id, unsigned char level
+) {
+    if ( (schd_id < 0) || (schd_id > last_schd) ) return;
+    schd_crits[schd_id] = level;
+};
+
+/**
+ * Turn on (or off) the overload detection of the event loop. The loop is
+ * considered overloaded once the scheduled tasks run later than
+ * `max_lateness` in `n_runs` consecutive `.run()`s, and to have recovered
+ * once they run on time in `recover_runs` consecutive `.run()`s, which is
+ * longer by default so that a borderline load does not flip the state back
+ * and forth. While overloaded,
+ * scheduled tasks with a criticality level below `shed_level` are skipped
+ * (but stay in phase), so that the remaining tasks can catch up. Reactions
+ * are never skipped.
+ * @param max_lateness - Longest lateness (in ms) considered on time.
+ * @param n_runs - Number of consecutive `.run()`s with scheduled tasks due
+ *     needed to enter or leave the overload. Set to 0 to turn the overload
+ *     detection off.
+ * @param shed_level - Scheduled tasks with criticality level below this are
+ *     skipped while overloaded. Default = 1.
+ * @param recover_runs - Number of consecutive `.run()`s with scheduled tasks
+ *     due, all on time, needed to leave the overload. Default = 0, which
+ *     means 4 * n_runs.
+ * @returns No explicit return.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::setOverload(
+    Time_t max_lateness, unsigned char n_runs, unsigned char shed_level,
+    unsigned int recover_runs
+) {
+    overload_lateness = max_lateness;
+    overload_runs = n_runs;
+    this->recover_runs = (recover_runs > 0) ? recover_runs : 4U * n_runs;
+    this->shed_level = shed_level;
+    overload_streak = 0;
+    if (n_runs == 0) is_overloaded = false;
+};
+
+/**
+ * Set the function to call when the event loop enters or leaves overload.
+ * @param callback - (Pointer to) function that takes true (on entering the
+ *     overload) or false (on leaving it) as input.
+ * @returns No explicit return.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::onOverload(
+    simpleEventsOverload * callback
+) {
+    overload_call = callback;
+};
+
+/**
+ * Check if the event loop is currently overloaded.
+ * @param - No input parameter
+ * @returns true if overloaded, false otherwise.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+bool SimpleEvents<T_MAX, R_MAX, Time_t>::isOverloaded(){
+    return is_overloaded;
+};
+
+#endif
+
+#ifdef SIMPLE_EVENTS_BUDGETS
+
+/**
+ * Set the time budget of a specific scheduled task identified by its id,
+ * i.e., the longest time its callback is expected to take. A callback that
+ * takes longer is recorded in the fault record (see `simpleEventsFaults()`).
+ * While a callback with a budget runs, the fault record also notes it as the
+ * running hook, so that if the board hangs and is reset (e.g., by the
+ * watchdog, see the SIMPLE_EVENTS_WATCHDOG flag, which is armed only while
+ * such a callback runs), the culprit is known.
+ * @param schd_id - The id of the scheduled task.
+ * @param budget - The time budget, in units of the clock of the event loop
+ *     (ms, unless changed by `.setClock()`). Set to 0 (the default) for no
+ *     budget, which also skips the bookkeeping.
+ *
+ * NOTE: only available if the SIMPLE_EVENTS_BUDGETS flag is defined BEFORE
+ * including this header.
+ *
+ * @returns No explicit return.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::setBudget(
+    int schd_id, unsigned long budget
+) {
+    if ( (schd_id < 0) || (schd_id > last_schd) ) return;
+    schd_budgets[schd_id] = budget;
+};
+
+/**
+ * Set the time budget of a specific reaction identified by its id. See
+ * `.setBudget()` for details.
+ * @param rct_id - The id of the reaction.
+ * @param budget - The time budget, in units of the clock of the event loop.
+ *     Set to 0 (the default) for no budget.
+ * @returns No explicit return.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::setReactionBudget(
+    int rct_id, unsigned long budget
+) {
+    if ( (rct_id < 0) || (rct_id > last_rct) ) return;
+    rct_budgets[rct_id] = budget;
+};
+
+#endif
+
+/*
+ * Get the time budget of a scheduled task, or 0 (no budget) if budgets are
+ * left out, see the SIMPLE_EVENTS_BUDGETS flag.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+unsigned long SimpleEvents<T_MAX, R_MAX, Time_t>::schdBudget(int schd_id){
+#ifdef SIMPLE_EVENTS_BUDGETS
+    return schd_budgets[schd_id];
+#else
+    (void) schd_id;
+    return 0;
+#endif
+};
+
+/*
+ * Get the time budget of a reaction, or 0 (no budget) if budgets are left
+ * out, see the SIMPLE_EVENTS_BUDGETS flag.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+unsigned long SimpleEvents<T_MAX, R_MAX, Time_t>::rctBudget(int rct_id){
+#ifdef SIMPLE_EVENTS_BUDGETS
+    return rct_budgets[rct_id];
+#else
+    (void) rct_id;
+    return 0;
+#endif
+};
+
+/**
+ * Run an action right after the current (or the next) pass of `.run()`,
+ * i.e., once all due schedules and reactions have run. This lets a callback
+ * stay short and leave its follow-up work (e.g., processing readings once
+ * all sensors are read) for later, without taking up a reaction slot.
+ *
+ * Deferred actions run in the order they are deferred, at the end of
+ * `.run()`. An action deferred by a deferred action runs at the end of the
+ * next `.run()`, and at most `.setDeferLimit()` actions run per `.run()`.
+ *
+ * NOTE that the queue is not protected against interrupts, so actions
+ * should be deferred from the main code (e.g., callbacks of the event loop)
+ * rather than from interrupt service routines.
+ *
+ * The queue holds SIMPLE_EVENTS_DEFER_MAX actions, which must be defined
+ * BEFORE including this header, since the queue is left out by default (and
+ * calling `.defer()` without it is a compile-time error).
+ *
+ * @param callback - (Pointer to) function to call.
+ * @returns true if queued, false if the queue (of SIMPLE_EVENTS_DEFER_MAX
+ *     actions) is full.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+bool SimpleEvents<T_MAX, R_MAX, Time_t>::defer(simpleEventsAction * callback){
+
+#if SIMPLE_EVENTS_DEFER_MAX > 0
+    if (dfr_count >= SIMPLE_EVENTS_DEFER_MAX) return false;
+
+    unsigned char slot = (dfr_head + dfr_count) % SIMPLE_EVENTS_DEFER_MAX;
+    dfr_calls[slot] = callback;
+    dfr_haveCtxs[slot] = false;
+    dfr_count++;
+
+    return true;
+#else
+    // (dependent on T_MAX, so that it fails only if .defer() is called)
+    static_assert(
+        T_MAX < 0,
+        "the defer queue is left out: define SIMPLE_EVENTS_DEFER_MAX "
+        "BEFORE including simpleEvents.h"
+    );
+    (void) callback;
+    return false;
+#endif
+};
+
+/**
+ * Run an action that takes a context (e.g., a pointer to the data to
+ * process) right after the current (or the next) pass of `.run()`. See
+ * `.defer()` above for details.
+ * @param callback - (Pointer to) function to call with the context.
+ * @param ctx - The context passed to the callback.
+ * @returns true if queued, false if the queue is full.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+bool SimpleEvents<T_MAX, R_MAX, Time_t>::defer(
+    simpleEventsDeferred * callback, void * ctx
+) {
+#if SIMPLE_EVENTS_DEFER_MAX > 0
+    if (dfr_count >= SIMPLE_EVENTS_DEFER_MAX) return false;
+
+    unsigned char slot = (dfr_head + dfr_count) % SIMPLE_EVENTS_DEFER_MAX;
+    dfr_calls[slot] = (simpleEventsAction *) callback;
+    dfr_ctxs[slot] = ctx;
+    dfr_haveCtxs[slot] = true;
+    dfr_count++;
+
+    return true;
+#else
+    static_assert(
+        T_MAX < 0,
+        "the defer queue is left out: define SIMPLE_EVENTS_DEFER_MAX "
+        "BEFORE including simpleEvents.h"
+    );
+    (void) callback;
+    (void) ctx;
+    return false;
+#endif
+};
+
+/**
+ * Set the largest number of deferred actions that run at the end of each
+ * `.run()`, to bound the time spent; the rest wait for the next `.run()`.
+ * @param limit - The number of actions (at least 1). Default (if the method
+ *     is never called) = SIMPLE_EVENTS_DEFER_MAX.
+ * @returns No explicit return.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::setDeferLimit(unsigned char limit){
+#if SIMPLE_EVENTS_DEFER_MAX > 0
+    dfr_limit = (limit > 0) ? limit : 1;
+#else
+    static_assert(
+        T_MAX < 0,
+        "the defer queue is left out: define SIMPLE_EVENTS_DEFER_MAX "
+        "BEFORE including simpleEvents.h"
+    );
+    (void) limit;
+#endif
+};
+
+/**
+ * Set the timers for all scheduled tasks and reactions.
+ * 
+ * The `.begin()` method should be called ONCE, AFTER all event hooks are
+ * added (via `addSchedule()` and `addReaction()`), but BEFORE the `.run()`
+ * method is ever called.
+ *
+ * In arduino the `.begin()` method is generally expected to be called 
+ * within the `setup()` function.
+ *
+ * @param - No input parameter
+ * @returns the timestamp at which the internal "clock tick" started
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+Time_t SimpleEvents<T_MAX, R_MAX, Time_t>::begin(){
+
+    Time_t now = tick(); // note that there is a common reference time
+    int i;
+
+    for (i = 0; i <= last_schd; i++){
+        schd_nextCalls[i] += now;
+    }
+
+    buildGroups();
+
+    for (i = 0; i <= last_rct; i++){
+        rct_nextTrigs[i] += now;
+    }
+
+    loop_flags.is_begun = true;
+
+    // a hook still marked as running means the board was reset during it
+    SimpleEventsFault & faults = simpleEventsFaults();
+    if (faults.magic != SIMPLE_EVENTS_FAULT_MAGIC){
+        faults.magic = SIMPLE_EVENTS_FAULT_MAGIC;
+        faults.hang_kind = SIMPLE_EVENTS_HOOK_NONE;
+        faults.overrun_kind = SIMPLE_EVENTS_HOOK_NONE;
+        faults.overrun_count = 0;
+    } else if (faults.running_kind != SIMPLE_EVENTS_HOOK_NONE){
+        faults.hang_kind = faults.running_kind;
+        faults.hang_id = faults.running_id;
+    }
+    faults.running_kind = SIMPLE_EVENTS_HOOK_NONE;
+
+    // the watchdog is only armed while a callback with a budget runs (on
+    // AVR, it was already disabled at start-up, see simpleEventsWdtOff())
+    SIMPLE_EVENTS_wdt_disable();
+
+    SIMPLE_EVENTS_print("SimpleEvents clock start ticking at millis() = ");
+    SIMPLE_EVENTS_println((unsigned long) now);
+
+    return now;
+
+};
+
+/**
+ * Save the timing state of the event loop (when each schedule and reaction
+ * is next due, the intervals, and which hooks are active or triggered) into
+ * a compact blob, e.g., in the RTC memory or the EEPROM before the board
+ * goes into deep sleep. The deadlines are saved relative to the current
+ * time, so that `.restore()` can rebase them after wakeup.
+ * @param blob - (Pointer to) the buffer that receives the snapshot.
+ * @param size - The size (in bytes) of the buffer, which needs at most
+ *     SNAPSHOT_MAX bytes.
+ * @returns The number of bytes written, or 0 if the buffer is too small.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+int SimpleEvents<T_MAX, R_MAX, Time_t>::snapshot(
+    unsigned char * blob, int size
+) {
+    Time_t now = tick();
+    Time_t rel;
+    unsigned char magic[2] = {
+        SIMPLE_EVENTS_SNAPSHOT_MAGIC >> 8, SIMPLE_EVENTS_SNAPSHOT_MAGIC & 0xFF
+    };
+    unsigned char n_schd = last_schd + 1;
+    unsigned char n_rct = last_rct + 1;
+    unsigned char flags;
+    int pos = 0;
+    int i;
+
+    if (size < 4 + n_schd * (2 * (int) sizeof(Time_t) + 2) +
+        n_rct * (2 * (int) sizeof(Time_t) + 1)) return 0;
+
+    packBytes(blob, pos, magic, 2);
+    packBytes(blob, pos, &n_schd, 1);
+    packBytes(blob, pos, &n_rct, 1);
+
+    for (i = 0; i <= last_schd; i++){
+        // bit 0: active; bit 1: late, i.e., rel is the lateness instead
+        flags = schd_flags[i].active ? 1 : 0;
+        if (schd_nextCalls[i] < now){
+            rel = now - schd_nextCalls[i];
+            flags |= 2;
+        } else {
+            rel = schd_nextCalls[i] - now;
+        }
+        packBytes(blob, pos, &rel, sizeof(Time_t));
+        packBytes(blob, pos, &schd_tIntrvls[i], sizeof(Time_t));
+        packBytes(blob, pos, &flags, 1);
+        packBytes(blob, pos, &schd_tries[i], 1);
+    }
+
+    for (i = 0; i <= last_rct; i++){
+        // bit 0: active; bit 1: triggered
+        flags = (rct_flags[i].active ? 1 : 0) | (rct_flags[i].trigged ? 2 : 0);
+        // reactions need no phase: a time already passed is saved as 0
+        rel = (rct_nextTrigs[i] > now) ? rct_nextTrigs[i] - now : 0;
+        packBytes(blob, pos, &rel, sizeof(Time_t));
+        rel = (rct_nextCalls[i] > now) ? rct_nextCalls[i] - now : 0;
+        packBytes(blob, pos, &rel, sizeof(Time_t));
+        packBytes(blob, pos, &flags, 1);
+    }
+
+    return pos;
+};
+
+/**
+ * Start the event loop from a snapshot taken by `.snapshot()`, e.g., after
+ * waking up from deep sleep, during which `millis()` stopped or was reset.
+ * Every deadline is rebased on the current time, less the time slept, so
+ * that the schedules keep their phase: a schedule that came due during the
+ * sleep skips the periods it missed (rather than running to catch up), and
+ * is next due where it would have been without the sleep. Monitors, retry
+ * schedules, child loops, and reactions that came due are due right away.
+ *
+ * The `.restore()` method is to be called INSTEAD OF `.begin()`, AFTER the
+ * same event hooks as for the snapshot are added (in the same order). If it
+ * returns false, call `.begin()` to start afresh.
+ *
+ * @param blob - (Pointer to) the buffer that holds the snapshot.
+ * @param size - The size (in bytes) of the buffer.
+ * @param elapsed - Time (in ms) elapsed since the snapshot was taken, e.g.,
+ *     the time slept as measured by a real-time clock.
+ * @returns true if restored, false if the blob is not a snapshot of the
+ *     same hooks (in which case the event loop is left unchanged).
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+bool SimpleEvents<T_MAX, R_MAX, Time_t>::restore(
+    const unsigned char * blob, int size, Time_t elapsed
+) {
+    Time_t now, rel, intrvl, overdue;
+    unsigned char magic[2] = { 0, 0 };
+    unsigned char n_schd = 0;
+    unsigned char n_rct = 0;
+    unsigned char flags;
+    int pos = 0;
+    int i;
+
+    if (size < 4) return false;
+    unpackBytes(blob, pos, magic, 2);
+    unpackBytes(blob, pos, &n_schd, 1);
+    unpackBytes(blob, pos, &n_rct, 1);
+    if (
+        ( ((magic[0] << 8) | magic[1]) != SIMPLE_EVENTS_SNAPSHOT_MAGIC ) ||
+        (n_schd != last_schd + 1) || (n_rct != last_rct + 1) ||
+        (size < 4 + n_schd * (2 * (int) sizeof(Time_t) + 2) +
+            n_rct * (2 * (int) sizeof(Time_t) + 1))
+    ) {
+        return false;
+    }
+
+    now = begin();
+
+    for (i = 0; i <= last_schd; i++){
+        unpackBytes(blob, pos, &rel, sizeof(Time_t));
+        unpackBytes(blob, pos, &intrvl, sizeof(Time_t));
+        unpackBytes(blob, pos, &flags, 1);
+        unpackBytes(blob, pos, &schd_tries[i], 1);
+        schd_tIntrvls[i] = intrvl;
+        schd_flags[i].active = ((flags & 1) != 0);
+
+        if ( !(flags & 2) && (rel > elapsed) ){
+            // not due yet
+            schd_nextCalls[i] = now + (rel - elapsed);
+            continue;
+        }
+
+        overdue = (flags & 2) ? rel + elapsed : elapsed - rel;
+        skipMissed(i, now, overdue);
+    }
+
+    for (i = 0; i <= last_rct; i++){
+        unpackBytes(blob, pos, &rel, sizeof(Time_t));
+        rct_nextTrigs[i] = now + ((rel > elapsed) ? rel - elapsed : 0);
+        unpackBytes(blob, pos, &rel, sizeof(Time_t));
+        rct_nextCalls[i] = now + ((rel > elapsed) ? rel - elapsed : 0);
+        unpackBytes(blob, pos, &flags, 1);
+        rct_flags[i].active = ((flags & 1) != 0);
+        rct_flags[i].trigged = ((flags & 2) != 0);
+    }
+
+    // the deadlines moved: regroup
+    buildGroups();
+
+    SIMPLE_EVENTS_println("SimpleEvents timing state restored");
+
+    return true;
+};
+
+/**
+ * Bring the deadlines that passed while the event loop was not run (e.g.,
+ * while it was paused as a child loop, see `.addChild()`) up to `now`. As
+ * with `.restore()`, the missed periods of the periodic tasks are skipped
+ * while keeping their phase, and the other overdue hooks (and child loops,
+ * which are rebased in turn) are due right away, so that nothing is run
+ * once for every period it missed.
+ * @param now - The current time (in units of the clock).
+ * @returns No explicit return.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::rebase(Time_t now){
+
+    int i;
+
+    for (i = 0; i <= last_schd; i++){
+        if (schd_flags[i].kind == SCHD_CHILD){
+            schd_nextCalls[i] = childDue(i, CHILD_REBASE, now);
+        } else if (
+            (schd_flags[i].kind != SCHD_IDLE) && (schd_nextCalls[i] < now)
+        ) {
+            skipMissed(i, now, now - schd_nextCalls[i]);
+        }
+    }
+
+    for (i = 0; i <= last_rct; i++){
+        if (rct_nextTrigs[i] < now) rct_nextTrigs[i] = now;
+    }
+
+    // the deadlines moved: regroup at the next run
+    loop_flags.grps_areStale = true;
+};
+
+/*
+ * Set the deadline of schedule i, which is `overdue` past its deadline at
+ * `now`: periodic tasks skip the missed periods, keeping the phase, and the
+ * others are due right away.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::skipMissed(
+    int i, Time_t now, Time_t overdue
+) {
+    Time_t intrvl = schd_tIntrvls[i];
+
+    if (
+        (intrvl > 0) && (
+            (schd_flags[i].kind == SCHD_PLAIN) ||
+            (schd_flags[i].kind == SCHD_TIMED) ||
+            (schd_flags[i].kind == SCHD_ADAPTIVE)
+        )
+    ) {
+        schd_nextCalls[i] = now + (intrvl - overdue % intrvl) % intrvl;
+    } else {
+        schd_nextCalls[i] = now;
+    }
+};
+
+/*
+ * Copy n bytes from src into the blob at pos, and advance pos.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::packBytes(
+    unsigned char * blob, int & pos, const void * src, int n
+) {
+    const unsigned char * bytes = (const unsigned char *) src;
+    while (n-- > 0) blob[pos++] = *bytes++;
+};
+
+/*
+ * Copy n bytes from the blob at pos into dst, and advance pos.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::unpackBytes(
+    const unsigned char * blob, int & pos, void * dst, int n
+) {
+    unsigned char * bytes = (unsigned char *) dst;
+    while (n-- > 0) *bytes++ = blob[pos++];
+};
+
+/*
+ * Read the clock of the event loop, extended to Time_t by the time base.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+Time_t SimpleEvents<T_MAX, R_MAX, Time_t>::tick(){
+    return time_base.extend((* clock)());
+};
+
+/*
+ * Sort the schedules into rate groups: plain and timed schedules with the
+ * same interval and the same next deadline join the group of the first such
+ * schedule (in order of id), while all other schedules form groups of their
+ * own. The members of a group are linked via schd_grpNexts (GRP_END ends
+ * the list), and the first members (heads) of all groups are listed in grp_heads.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::buildGroups(){
+
+    int i, g, k;
+    bool found;
+
+    last_grp = -1;
+
+    for (i = 0; i <= last_schd; i++){
+        schd_grpNexts[i] = GRP_END;
+        found = false;
+
+        // idle hooks have no deadline, and are run by .runIdle() instead
+        if (schd_flags[i].kind == SCHD_IDLE) continue;
+
+        if ( (schd_flags[i].kind == SCHD_PLAIN) || (schd_flags[i].kind == SCHD_TIMED) ){
+            for (g = 0; (g <= last_grp) && !found; g++){
+                k = grp_heads[g];
+                if (
+                    ( (schd_flags[k].kind == SCHD_PLAIN) ||
+                      (schd_flags[k].kind == SCHD_TIMED) ) &&
+                    (schd_tIntrvls[k] == schd_tIntrvls[i]) &&
+                    (schd_nextCalls[k] == schd_nextCalls[i])
+                ) {
+                    // append to the end of the group
+                    while (schd_grpNexts[k] != GRP_END) k = schd_grpNexts[k];
+                    schd_grpNexts[k] = i;
+                    found = true;
+                }
+            }
+        }
+
+        if (!found) grp_heads[++last_grp] = i;
+    }
+
+    loop_flags.grps_areStale = false;
+};
+
+#ifdef SIMPLE_EVENTS_OVERLOAD
+
+/*
+ * Update the overload state after a `.run()` in which scheduled tasks were
+ * due, given whether any of them was later than overload_lateness. The
+ * streak counts the consecutive runs that contradict the current state.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::checkOverload(bool late){
+
+    if (late != is_overloaded){
+        overload_streak++;
+    } else {
+        overload_streak = 0;
+    }
+
+    // leaving the overload takes longer than entering it (hysteresis)
+    if (overload_streak < (is_overloaded ? recover_runs : overload_runs)){
+        return;
+    }
+
+    overload_streak = 0;
+    is_overloaded = late;
+    SIMPLE_EVENTS_println(late ? "Overload entered" : "Overload left");
+    if (overload_call != nullptr) (* overload_call)(late);
+};
+
+#endif
+
+/*
+ * Check whether schedule i is skipped (shed) because the loop is overloaded.
+ * Never the case if the overload detection is left out.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+bool SimpleEvents<T_MAX, R_MAX, Time_t>::isShed(int i){
+#ifdef SIMPLE_EVENTS_OVERLOAD
+    return is_overloaded && (schd_crits[i] < shed_level);
+#else
+    (void) i;
+    return false;
+#endif
+};
+
+/*
+ * Note a hook with a time budget as running in the fault record, and arm
+ * the watchdog (if enabled), just before its callback. The hook that was
+ * running around it (e.g., the hook of a parent loop that runs this loop as
+ * a child) is saved in the guard, together with the start time.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::guardStart(
+    unsigned char kind, int id, Guard & guard
+) {
+    SimpleEventsFault & faults = simpleEventsFaults();
+
+    guard.outer_kind = faults.running_kind;
+    guard.outer_id = faults.running_id;
+    faults.running_id = id;
+    faults.running_kind = kind;
+    SIMPLE_EVENTS_wdt_enable();
+    guard.start = tick();
+};
+
+/*
+ * Restore the running hook in the fault record just after the callback,
+ * disarm the watchdog (or re-arm it for the outer hook), and record an
+ * overrun if the callback took longer than its budget.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::guardEnd(
+    unsigned char kind, int id, const Guard & guard, unsigned long budget
+) {
+    SimpleEventsFault & faults = simpleEventsFaults();
+    unsigned long elapsed = (unsigned long) (tick() - guard.start);
+
+    faults.running_id = guard.outer_id;
+    faults.running_kind = guard.outer_kind;
+    if (guard.outer_kind == SIMPLE_EVENTS_HOOK_NONE){
+        SIMPLE_EVENTS_wdt_disable();
+    } else {
+        SIMPLE_EVENTS_wdt_reset();
+    }
+    if (elapsed <= budget) return;
+
+    faults.overrun_kind = kind;
+    faults.overrun_id = id;
+    faults.overrun_elapsed = elapsed;
+    faults.overrun_count++;
+    SIMPLE_EVENTS_print("Budget exceeded by hook #");
+    SIMPLE_EVENTS_println(id);
+};
+
+#ifdef SIMPLE_EVENTS_PRECISION
+
+/*
+ * Busy-wait until the earliest deadline of the active schedules and pending
+ * reactions has passed, provided that it is within spin_threshold of `now`.
+ * The wait is also bounded by spin_threshold itself, so that a clock that
+ * wraps around (or skips) past the deadline cannot hang the loop. Returns
+ * the (possibly updated) current time.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+Time_t SimpleEvents<T_MAX, R_MAX, Time_t>::spinUntilDue(Time_t now){
+
+    Time_t due = nextDue();
+    Time_t start = now;
+
+    // nothing close enough: return to loop() instead
+    if (!(due < now + spin_threshold)) return now;
+
+    while ( !(due < now) && ((Time_t) (now - start) < spin_threshold) ){
+        now = tick();
+    }
+
+    return now;
+};
+
+#endif
+
+/*
+ * Note the lateness of a hook for `.maxJitter()` (in precision mode only).
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::noteJitter(Time_t late){
+#ifdef SIMPLE_EVENTS_PRECISION
+    if ( (spin_threshold > 0) && (late > max_jitter) ) max_jitter = late;
+#else
+    (void) late;
+#endif
+};
+
+/*
+ * Invoke the callback of a schedule that is not a plain periodic task, and
+ * update the schedule according to its kind.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::callSchedule(int i, Time_t now){
+
+    Time_t wait;
+    unsigned char shift;
+
+    switch (schd_flags[i].kind){
+
+      case SCHD_TIMED:
+        // the deadline already moved by the interval
+        (* (simpleEventsTimedAction *) schd_calls[i])(
+            (unsigned long) now,
+            (unsigned long) (now - (schd_nextCalls[i] - schd_tIntrvls[i]))
+        );
+        break;
+
+      case SCHD_CHILD:
+        // wait for the earliest deadline of the child after this run
+        schd_nextCalls[i] = childDue(i, CHILD_RUN, now);
+        break;
+
+      case SCHD_MONITOR:
+        // timed out: done until kicked again (but keep the pause flag of
+        // the user apart)
+        if (schd_tries[i] > 0) break;
+        schd_tries[i] = 1;
+        SIMPLE_EVENTS_print("Monitor #");
+        SIMPLE_EVENTS_print(i);
+        SIMPLE_EVENTS_println(" timed out");
+        // callback is last to allow for self-manipulation
+        (* schd_calls[i])();
+        break;
+
+      case SCHD_ADAPTIVE:
+        wait = (* (simpleEventsAdaptive *) schd_calls[i])();
+        if (wait != 0){
+            // the deadline already moved by the old interval: swap it for
+            // the new one in place, keeping the phase
+            schd_nextCalls[i] += wait - schd_tIntrvls[i];
+            schd_tIntrvls[i] = wait;
+        }
+        break;
+
+      case SCHD_RETRY:
+        if ((* (simpleEventsAttempt *) schd_calls[i])()){
+            // success: done until restarted
+            schd_tries[i] = 0;
+            schd_flags[i].active = false;
+        } else if (++schd_tries[i] >= schd_maxTries[i]){
+            // final failure: done until restarted
+            schd_tries[i] = 0;
+            schd_flags[i].active = false;
+            SIMPLE_EVENTS_print("Schedule #");
+            SIMPLE_EVENTS_print(i);
+            SIMPLE_EVENTS_println(" gave up");
+            // callback is last to allow for self-manipulation
+            if (schd_ctxs[i] != nullptr){
+                (* (simpleEventsAction *) schd_ctxs[i])();
+            }
+        } else {
+            // failure: re-arm the deadline with exponential backoff
+            shift = schd_tries[i] - 1;
+            if (shift > 15) shift = 15;
+            wait = schd_tIntrvls[i] << shift;
+            schd_nextCalls[i] = now + wait + random((long) (wait / 4 + 1));
+            SIMPLE_EVENTS_print("Schedule #");
+            SIMPLE_EVENTS_print(i);
+            SIMPLE_EVENTS_println(" failed, retry scheduled");
+        }
+        break;
+    }
+};
+
+/*
+ * Run (CHILD_RUN) or rebase at `now` (CHILD_REBASE) a child event loop of
+ * type Child, or leave it be (CHILD_QUERY), and return the time at which
+ * the child next has something to do (see `.nextRun()`). For CHILD_DUE,
+ * return the earliest deadline of the child (see `.nextDue()`) instead.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+template <typename Child>
+Time_t SimpleEvents<T_MAX, R_MAX, Time_t>::runChild(
+    void * child, unsigned char op, Time_t now
+) {
+    if (op == CHILD_DUE) return ((Child *) child)->nextDue();
+    if (op == CHILD_RUN) ((Child *) child)->run();
+    if (op == CHILD_REBASE) ((Child *) child)->rebase(now);
+    return ((Child *) child)->nextRun();
+};
+
+/*
+ * Act on the child loop of hook i (see .runChild()), and return its next
+ * due time, brought forward to just before `now` if it is in the past, so
+ * that the child is run by the next .run() without counting as late.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+Time_t SimpleEvents<T_MAX, R_MAX, Time_t>::childDue(
+    int i, unsigned char op, Time_t now
+) {
+    Time_t due = (* (childRunner *) schd_calls[i])(schd_ctxs[i], op, now);
+    if ( (due < now) && (now > 0) ) due = now - 1;
+    return due;
+};
+
+/*
+ * Call the active idle hooks, in order, for as long as the time until the
+ * next deadline exceeds their thresholds, each with that time (capped at
+ * idle_slice) as its budget. The time is read again before each hook,
+ * since the previous hook used up some of it.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::runIdle(){
+
+    Time_t now, due, slice;
+    Guard guard;
+    unsigned long budget;
+    int i;
+
+    for (i = 0; i <= last_schd; i++){
+        if ( (schd_flags[i].kind != SCHD_IDLE) || !schd_flags[i].active ) continue;
+        now = tick();
+        due = nextDue();
+        if ( (due <= now) || (due - now <= schd_tIntrvls[i]) ) continue;
+        slice = (due - now < idle_slice) ? due - now : idle_slice;
+        budget = schdBudget(i);
+        if (budget > 0) guardStart(SIMPLE_EVENTS_HOOK_SCHEDULE, i, guard);
+        (* (simpleEventsIdle *) schd_calls[i])((unsigned long) slice);
+        if (budget > 0){
+            guardEnd(SIMPLE_EVENTS_HOOK_SCHEDULE, i, guard, budget);
+        }
+        SIMPLE_EVENTS_print("Idle hook #");
+        SIMPLE_EVENTS_print(i);
+        SIMPLE_EVENTS_println(" executed");
+    }
+};
+
+/*
+ * Run the deferred actions that are queued at the start of the call (at
+ * most dfr_limit of them), oldest first.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::runDeferred(){
+
+#if SIMPLE_EVENTS_DEFER_MAX > 0
+    unsigned char n = (dfr_count < dfr_limit) ? dfr_count : dfr_limit;
+    unsigned char slot;
+
+    while (n-- > 0){
+        slot = dfr_head;
+        // free the slot first, so that the action can defer another one
+        dfr_head = (dfr_head + 1) % SIMPLE_EVENTS_DEFER_MAX;
+        dfr_count--;
+        if (dfr_haveCtxs[slot]){
+            (* (simpleEventsDeferred *) dfr_calls[slot])(dfr_ctxs[slot]);
+        } else {
+            (* dfr_calls[slot])();
+        }
+    }
+#endif
+};
+
+/*
+ * Register the reactions woken by .wakeReaction() since the last call as
+ * triggered at `now`.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::takeWakes(Time_t now){
+
+    Time_t due;
+    int i;
+
+    // clear the summary flag first: a wake from an interrupt during the
+    // scan sets it again, and is then taken up by the next .run()
+    any_woken = false;
+
+    for (i = 0; i <= last_rct; i++){
+        if (!rct_areWoken[i]) continue;
+        rct_areWoken[i] = false;
+        if (rct_flags[i].trigged) continue;
+        // due one tick early, since a pending reaction runs only once the
+        // clock is past its due time
+        due = now + rct_tDelays[i];
+        rct_nextCalls[i] = (due > 0) ? due - 1 : due;
+        rct_flags[i].trigged = true;
+        SIMPLE_EVENTS_print("Reaction #");
+        SIMPLE_EVENTS_print(i);
+        SIMPLE_EVENTS_println(" woken");
+    }
+};
+
+/*
+ * Invoke the callback of a reaction, passing the time and the lateness
+ * (relative to the time the call was due) to timed reactions.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::callReaction(
+    int i, Time_t now, Time_t due
+) {
+    unsigned long budget = rctBudget(i);
+    Guard guard;
+
+    if (budget > 0) guardStart(SIMPLE_EVENTS_HOOK_REACTION, i, guard);
+
+    if (rct_flags[i].timed){
+        (* (simpleEventsTimedAction *) rct_calls[i])(
+            (unsigned long) now, (unsigned long) (now - due)
+        );
+    } else {
+        (* rct_calls[i])();
+    }
+
+    if (budget > 0) guardEnd(SIMPLE_EVENTS_HOOK_REACTION, i, guard, budget);
+};
+
+/**
+ * Execute any overdue scheduled tasks and reactions, then check and register
+ * any overdue triggers.
+ * 
+ * In arduino the `.run()` method is intended to be used inside the 
+ * `loop()` function so as to create an event LOOP.
+ * 
+ * @param - No input parameter
+ * @returns No explicit return.
+ */
+template <int T_MAX, int R_MAX, typename Time_t>
+void SimpleEvents<T_MAX, R_MAX, Time_t>::run(){
+
+    Time_t now = tick(); // again, a common reference time for all actions
+    Time_t late;
+    Guard guard;
+    unsigned long budget;
+#ifdef SIMPLE_EVENTS_OVERLOAD
+    bool any_due = false;
+    bool any_late = false;
+#endif
+    unsigned char due_grps[T_MAX]; // next member to run in each due group
+    int n_due = 0;
+    int i, g, k;
+
+    // regroup after a schedule is restarted or its interval changed
+    if (loop_flags.grps_areStale) buildGroups();
+
+    // in precision mode, wait for a deadline that is about to pass
+#ifdef SIMPLE_EVENTS_PRECISION
+    if (spin_threshold > 0) now = spinUntilDue(now);
+#endif
+
+    // a child loop may have been kicked, woken, etc. since the last run
+    if (loop_flags.has_child){
+        for (i = 0; i <= last_schd; i++){
+            if (schd_flags[i].active && (schd_flags[i].kind == SCHD_CHILD)){
+                schd_nextCalls[i] = childDue(i, CHILD_QUERY, now);
+            }
+        }
+    }
+
+    // first execute scheduled (periodic) tasks, one deadline per rate group
+    for (g = 0; g <= last_grp; g++){
+        if (schd_nextCalls[grp_heads[g]] < now){
+            due_grps[n_due++] = grp_heads[g];
+        }
+    }
+
+    // the members of the due groups, merged back in the order of their ids
+    while (n_due > 0){
+        k = 0;
+        for (g = 1; g < n_due; g++){
+            if (due_grps[g] < due_grps[k]) k = g;
+        }
+        i = due_grps[k];
+        if (schd_grpNexts[i] != GRP_END){
+            due_grps[k] = schd_grpNexts[i];
+        } else {
+            due_grps[k] = due_grps[--n_due];
+        }
+        // the members share the deadline, unless changed by a callback
+        if (schd_nextCalls[i] >= now) continue;
+        // a child loop is late only by its own hooks, which it accounts for
+        if (schd_flags[i].active && (schd_flags[i].kind != SCHD_CHILD)){
+            late = now - schd_nextCalls[i];
+#ifdef SIMPLE_EVENTS_OVERLOAD
+            any_due = true;
+            if (late > overload_lateness) any_late = true;
+#endif
+            noteJitter(late);
+        }
+        // no `now`: keep the "ticks" synchronized with the initial tick
+        // always keep the clock ticking regardless of whether task active
+        schd_nextCalls[i] += schd_tIntrvls[i];
+        if (schd_flags[i].active && !isShed(i)){
+            // callback only if the task is active (and not shed)
+            // callback is last to allow for self-manipulation
+            budget = schdBudget(i);
+            if (budget > 0){
+                guardStart(SIMPLE_EVENTS_HOOK_SCHEDULE, i, guard);
+            }
+            if (schd_flags[i].kind == SCHD_PLAIN){
+                (* schd_calls[i])();
+            } else {
+                callSchedule(i, now);
+            }
+            if (budget > 0){
+                guardEnd(SIMPLE_EVENTS_HOOK_SCHEDULE, i, guard, budget);
+            }
+            SIMPLE_EVENTS_print("Schedule #");
+            SIMPLE_EVENTS_print(i);
+            SIMPLE_EVENTS_println(" executed");
+        }
+    }
+
+#ifdef SIMPLE_EVENTS_OVERLOAD
+    if ( (overload_runs > 0) && any_due ) checkOverload(any_late);
+#endif
+
+    // then register the reactions woken since the last run
+    if (any_woken) takeWakes(now);
+
+    // then execute pending reactions that are already triggered
+    for (i = 0; i <= last_rct; i++){
+        if (rct_flags[i].trigged && (rct_nextCalls[i] < now)){
+            rct_flags[i].trigged = false;
+            noteJitter(now - rct_nextCalls[i]);
+            // callback is last to allow for self-manipulation
+            callReaction(i, now, rct_nextCalls[i]);
+            SIMPLE_EVENTS_print("Reaction #");
+            SIMPLE_EVENTS_print(i);
+            SIMPLE_EVENTS_println(" executed");
+        }
+    }
+
+    // then check for any new trigger for reactions
+    for (i = 0; i <= last_rct; i++){
+        if (
+            rct_flags[i].active && (rct_nextTrigs[i] < now) &&
+            (* rct_trigs[i])()
+        ) {
+            if (rct_tDelays[i] == 0){
+                // if reaction is immediate, directly execute it
+                rct_nextTrigs[i] = now + rct_tTimeouts[i];
+                // callback is last to allow for self-manipulation
+                callReaction(i, now, now);
+                SIMPLE_EVENTS_print("Reaction #");
+                SIMPLE_EVENTS_print(i);
+                SIMPLE_EVENTS_println(" triggered and executed");
+            } else {
+                // else register it to run
+                rct_nextTrigs[i] = now + rct_tTimeouts[i];
                 rct_nextCalls[i] = now + rct_tDelays[i];
-                rct_areTrigged[i] = true;
+                rct_flags[i].trigged = true;
                 SIMPLE_EVENTS_print("Reaction #");
                 SIMPLE_EVENTS_print(i);
                 SIMPLE_EVENTS_println(" triggered");
@@ -414,6 +2174,12 @@ void SimpleEvents<T_MAX, R_MAX>::run(){
         }
     }
 
+    // then run the follow-up work deferred by the callbacks
+    if (dfr_count > 0) runDeferred();
+
+    // finally use the spare time, if any, for the idle hooks
+    if (loop_flags.has_idle) runIdle();
+
 };
 
 #endif
@@ -0,0 +1,397 @@
+/**
+ * @file Implement a `SimpleEventsAnalyzer` class that estimates, before a
+ * schedule set is shipped, how heavily it loads the event loop.
+ *
+ * The analyzer is given the same hooks as the event loop (the interval and
+ * delay_start of each schedule, and the timeout and delay of each reaction),
+ * together with an estimate of how long each callback takes (e.g., measured
+ * with `micros()`). It then simulates the schedules over one hyperperiod
+ * (the time after which the pattern of due schedules repeats), and reports:
+ *  + the peak number of callbacks, and the peak total cost of the callbacks,
+ *    that fall due in a single `.run()`;
+ *  + the average load, i.e., the fraction of the time spent in callbacks;
+ *  + the number of deadline misses, i.e., callbacks that (due to the work
+ *    queued in front of them) finish after the schedule is due again.
+ *
+ * Reactions are sporadic, so they are counted at their worst: each reaction
+ * is assumed to land in the busiest `.run()`, and to fire as often as its
+ * timeout allows. The delay of a reaction only shifts when its callback runs,
+ * and so does not change the worst case.
+ *
+ * Finally, `.suggestOffsets()` looks for delay_start values that spread the
+ * schedules apart and so reduce the peak cost of a single `.run()`.
+ *
+ * The analyzer does not depend on the Arduino core, so the same header can
+ * be used in a sketch (e.g., printing the report to Serial in `setup()`) or
+ * in a small program on the host computer.
+ *
+ * NOTE: due to the use of template, all functionalities of the
+ * `SimpleEventsAnalyzer` class are implemented directly in the
+ * `simpleEventsAnalyzer.h` header file. In other words, there is no
+ * separated `.cpp` file.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#ifndef SIMPLE_EVENTS_ANALYZER_H_
+#define SIMPLE_EVENTS_ANALYZER_H_
+
+// longest time span (in ms) that the analyzer simulates, i.e., the largest
+// delay_start plus two hyperperiods; this keeps all times in microseconds
+// within the range of an unsigned long
+#define SIMPLE_EVENTS_ANALYZER_MAX_SPAN 2000000UL
+
+/**
+ * class declaration for the SimpleEventsAnalyzer class.
+ * @param - NO input parameters to the constructor. However, template
+ *     parameters that controls the maximum number of hooks of each type may
+ *     optionally be supplied.
+ */
+template <int T_MAX = 8, int R_MAX = 8>
+class SimpleEventsAnalyzer {
+
+  private:
+    int last_schd = -1;
+    int last_rct = -1;
+
+    unsigned long schd_tIntrvls[T_MAX] = { 0 };
+    unsigned long schd_tOffsets[T_MAX] = { 0 };
+    unsigned long schd_costs[T_MAX] = { 0 };
+    unsigned long schd_suggested[T_MAX] = { 0 };
+
+    unsigned long rct_tTimeouts[R_MAX] = { 0 };
+    unsigned long rct_costs[R_MAX] = { 0 };
+
+    unsigned long hyper = 0;
+    unsigned int peak_calls = 0;
+    unsigned long peak_cost = 0;
+    float avg_load = 0;
+    unsigned int miss_count = 0;
+
+    static unsigned long gcd(unsigned long, unsigned long);
+    bool isDue(int, unsigned long, unsigned long);
+    unsigned long costAt(unsigned long, const bool *);
+
+  public:
+    int addSchedule(unsigned long, unsigned long, unsigned long);
+    int addReaction(unsigned long, unsigned long, unsigned long);
+    bool analyze();
+    unsigned long hyperperiod();
+    unsigned int peakCallbacks();
+    unsigned long peakCost();
+    float averageLoad();
+    unsigned int misses();
+    unsigned long suggestOffsets();
+    unsigned long suggestedOffset(int);
+};
+
+/*
+ * Greatest common divisor, with gcd(0, b) = b.
+ */
+template <int T_MAX, int R_MAX>
+unsigned long SimpleEventsAnalyzer<T_MAX, R_MAX>::gcd(
+    unsigned long a, unsigned long b
+) {
+    unsigned long t;
+    while (b != 0){
+        t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+};
+
+/*
+ * Whether schedule i is due at time t (in ms, taken modulo the hyperperiod
+ * so that the delay_start only sets the phase), given its offset.
+ */
+template <int T_MAX, int R_MAX>
+bool SimpleEventsAnalyzer<T_MAX, R_MAX>::isDue(
+    int i, unsigned long offset, unsigned long t
+) {
+    return (t % schd_tIntrvls[i]) == (offset % schd_tIntrvls[i]);
+};
+
+/*
+ * Total cost of the schedules (with the suggested offsets) that fall due at
+ * time t, counting only those flagged in `included` (or all if nullptr).
+ */
+template <int T_MAX, int R_MAX>
+unsigned long SimpleEventsAnalyzer<T_MAX, R_MAX>::costAt(
+    unsigned long t, const bool * included
+) {
+    unsigned long cost = 0;
+    int j;
+    for (j = 0; j <= last_schd; j++){
+        if (
+            ((included == nullptr) || included[j]) &&
+            isDue(j, schd_suggested[j], t)
+        ) {
+            cost += schd_costs[j];
+        }
+    }
+    return cost;
+};
+
+/**
+ * Add a schedule to be analyzed, with the same timing as given to
+ * `.addSchedule()` of the event loop.
+ * @param interval - Time (in ms) interval between successive runs.
+ * @param delay_start - Time delay (in ms) before the first run.
+ * @param cost - Estimated time (in us) taken by the callback.
+ * @returns the id of the schedule (same as in the event loop if the hooks
+ *     are added in the same order), -1 if the maximum number of schedules is
+ *     reached or the interval is 0.
+ */
+template <int T_MAX, int R_MAX>
+int SimpleEventsAnalyzer<T_MAX, R_MAX>::addSchedule(
+    unsigned long interval, unsigned long delay_start, unsigned long cost
+) {
+    if ( (last_schd >= T_MAX - 1) || (interval == 0) ) return -1;
+
+    last_schd++;
+    schd_tIntrvls[last_schd] = interval;
+    schd_tOffsets[last_schd] = delay_start;
+    schd_costs[last_schd] = cost;
+    schd_suggested[last_schd] = delay_start % interval;
+
+    return last_schd;
+};
+
+/**
+ * Add a reaction to be analyzed, with the same timing as given to
+ * `.addReaction()` of the event loop.
+ * @param timeout - Time (in ms) before the trigger is checked again after
+ *     it fires, which limits how often the reaction can run.
+ * @param delay - Time delay (in ms) between trigger and callback.
+ * @param cost - Estimated time (in us) taken by the callback.
+ * @returns the id of the reaction, -1 if the maximum number of reactions
+ *     is reached.
+ */
+template <int T_MAX, int R_MAX>
+int SimpleEventsAnalyzer<T_MAX, R_MAX>::addReaction(
+    unsigned long timeout, unsigned long delay, unsigned long cost
+) {
+    if (last_rct >= R_MAX - 1) return -1;
+
+    (void) delay; // does not change the worst case, see the @file comment
+
+    last_rct++;
+    rct_tTimeouts[last_rct] = timeout;
+    rct_costs[last_rct] = cost;
+
+    return last_rct;
+};
+
+/**
+ * Simulate the schedules (with their given delay_start) over one
+ * hyperperiod, and compute the report.
+ * @param - No input parameter
+ * @returns true if the analysis is done, false if there is no schedule or
+ *     the time span to simulate (the largest delay_start plus two
+ *     hyperperiods) is longer than SIMPLE_EVENTS_ANALYZER_MAX_SPAN.
+ */
+template <int T_MAX, int R_MAX>
+bool SimpleEventsAnalyzer<T_MAX, R_MAX>::analyze(){
+
+    int i;
+    unsigned long t, start, finish, busy, cost, total;
+    unsigned int calls;
+    unsigned long max_offset = 0;
+
+    hyper = 0;
+    peak_calls = 0;
+    peak_cost = 0;
+    avg_load = 0;
+    miss_count = 0;
+
+    if (last_schd < 0) return false;
+
+    hyper = 1;
+    for (i = 0; i <= last_schd; i++){
+        hyper = hyper / gcd(hyper, schd_tIntrvls[i]) * schd_tIntrvls[i];
+        if (schd_tOffsets[i] > max_offset) max_offset = schd_tOffsets[i];
+        if (max_offset + 2 * hyper > SIMPLE_EVENTS_ANALYZER_MAX_SPAN){
+            hyper = 0;
+            return false;
+        }
+    }
+
+    // skip the first hyperperiod after the last delay_start, so that the
+    // backlog at the start of the measured hyperperiod is a steady one
+    busy = 0;
+    total = 0;
+    for (t = 0; t < max_offset + 2 * hyper; t++){
+        calls = 0;
+        cost = 0;
+        for (i = 0; i <= last_schd; i++){
+            if (
+                (t < schd_tOffsets[i]) ||
+                ((t - schd_tOffsets[i]) % schd_tIntrvls[i] != 0)
+            ) continue;
+
+            start = (busy > t * 1000UL) ? busy : t * 1000UL;
+            finish = start + schd_costs[i];
+            busy = finish;
+
+            if (t < max_offset + hyper) continue;
+
+            calls++;
+            cost += schd_costs[i];
+            if (finish > (t + schd_tIntrvls[i]) * 1000UL) miss_count++;
+        }
+        if (calls > peak_calls) peak_calls = calls;
+        if (cost > peak_cost) peak_cost = cost;
+        total += cost;
+    }
+
+    avg_load = (float) total / (1000.0f * hyper);
+
+    // worst case for reactions: all land in the busiest run, as often as
+    // their timeouts allow
+    for (i = 0; i <= last_rct; i++){
+        peak_calls++;
+        peak_cost += rct_costs[i];
+        avg_load += (float) rct_costs[i] /
+            (1000.0f * (rct_tTimeouts[i] > 0 ? rct_tTimeouts[i] : 1));
+    }
+
+    return true;
+};
+
+/**
+ * Get the hyperperiod computed by `.analyze()`.
+ * @param - No input parameter
+ * @returns The hyperperiod (in ms), or 0 if the analysis failed.
+ */
+template <int T_MAX, int R_MAX>
+unsigned long SimpleEventsAnalyzer<T_MAX, R_MAX>::hyperperiod(){
+    return hyper;
+};
+
+/**
+ * Get the largest number of callbacks that fall due in a single `.run()`.
+ * @param - No input parameter
+ * @returns The peak number of callbacks per `.run()`.
+ */
+template <int T_MAX, int R_MAX>
+unsigned int SimpleEventsAnalyzer<T_MAX, R_MAX>::peakCallbacks(){
+    return peak_calls;
+};
+
+/**
+ * Get the largest total cost of the callbacks that fall due in a single
+ * `.run()`, i.e., the longest that a single `.run()` may take.
+ * @param - No input parameter
+ * @returns The peak cost (in us) per `.run()`.
+ */
+template <int T_MAX, int R_MAX>
+unsigned long SimpleEventsAnalyzer<T_MAX, R_MAX>::peakCost(){
+    return peak_cost;
+};
+
+/**
+ * Get the average load, i.e., the fraction of the time spent in callbacks.
+ * A value at or above 1 means the loop cannot keep up.
+ * @param - No input parameter
+ * @returns The average load (as a fraction between 0 and 1).
+ */
+template <int T_MAX, int R_MAX>
+float SimpleEventsAnalyzer<T_MAX, R_MAX>::averageLoad(){
+    return avg_load;
+};
+
+/**
+ * Get the number of deadline misses over one hyperperiod, i.e., callbacks
+ * that finish after their schedule is due again.
+ * @param - No input parameter
+ * @returns The number of deadline misses.
+ */
+template <int T_MAX, int R_MAX>
+unsigned int SimpleEventsAnalyzer<T_MAX, R_MAX>::misses(){
+    return miss_count;
+};
+
+/**
+ * Look for delay_start values that reduce the peak cost of a single
+ * `.run()`. The schedules are placed one at a time, the most costly first,
+ * each at the offset (within its interval, in steps of the greatest common
+ * divisor of all intervals) where it adds the least to the busiest `.run()`
+ * so far.
+ *
+ * NOTE that the search takes time proportional to the number of schedules
+ * squared times the hyperperiod, so it is better done on the host computer
+ * or once in `setup()`. Also note that `.analyze()` must succeed first.
+ *
+ * @param - No input parameter
+ * @returns The peak cost (in us) of the schedules with the suggested
+ *     offsets, or 0 if there is no valid analysis.
+ */
+template <int T_MAX, int R_MAX>
+unsigned long SimpleEventsAnalyzer<T_MAX, R_MAX>::suggestOffsets(){
+
+    if (hyper == 0) return 0;
+
+    bool placed[T_MAX] = { false };
+    unsigned long step = 0;
+    unsigned long offset, best_offset, peak, best_peak, t, c;
+    int n, i, k;
+
+    for (i = 0; i <= last_schd; i++) step = gcd(step, schd_tIntrvls[i]);
+
+    for (n = 0; n <= last_schd; n++){
+
+        // pick the most costly schedule not placed yet
+        k = -1;
+        for (i = 0; i <= last_schd; i++){
+            if ( !placed[i] && ((k < 0) || (schd_costs[i] > schd_costs[k])) ){
+                k = i;
+            }
+        }
+
+        best_offset = 0;
+        best_peak = 0;
+        for (offset = 0; offset < schd_tIntrvls[k]; offset += step){
+            peak = 0;
+            for (t = offset; t < hyper; t += schd_tIntrvls[k]){
+                // only the schedules placed so far count toward the peak
+                c = costAt(t, placed);
+                if (c > peak) peak = c;
+            }
+            if ( (offset == 0) || (peak < best_peak) ){
+                best_peak = peak;
+                best_offset = offset;
+            }
+        }
+
+        schd_suggested[k] = best_offset;
+        placed[k] = true;
+    }
+
+    peak = 0;
+    for (t = 0; t < hyper; t += step){
+        c = costAt(t, nullptr);
+        if (c > peak) peak = c;
+    }
+
+    return peak;
+};
+
+/**
+ * Get the delay_start suggested by `.suggestOffsets()` for a schedule.
+ * @param schd_id - The id of the schedule.
+ * @returns The suggested delay_start (in ms), or 0 for an invalid id.
+ */
+template <int T_MAX, int R_MAX>
+unsigned long SimpleEventsAnalyzer<T_MAX, R_MAX>::suggestedOffset(
+    int schd_id
+) {
+    if ( (schd_id < 0) || (schd_id > last_schd) ) return 0;
+    return schd_suggested[schd_id];
+};
+
+#endif
@@ -0,0 +1,344 @@
+/**
+ * @file Implement streaming filter stages that can be chained behind a
+ * sampled input (e.g., a schedule that calls `analogRead()`, or the blocks
+ * of a `SimpleSampler`) before feeding reactions or schedules.
+ *
+ * The following stages are provided:
+ *  + `SimpleMovingAverage`: integer average over the last N samples.
+ *  + `SimpleEMA`: exponential moving average with a smoothing factor of
+ *    1 / 2^SHIFT, in fixed-point arithmetic.
+ *  + `SimpleMedian`: median over the last N samples (rejects spikes).
+ *  + `SimpleFilterChain`: two stages (possibly chains themselves) in series.
+ *
+ * All stages share the same interface: `.update()` takes one sample and
+ * returns the filtered value, `.value()` returns the last filtered value,
+ * `.reset()` clears the history, and `.process()` filters a whole block of
+ * samples. No stage allocates memory: the history is sized by template
+ * parameters, and only integer additions, subtractions and shifts (plus a
+ * division by a compile-time constant in `SimpleMovingAverage`) are used,
+ * so that the filters stay cheap on 8-bit controllers without floating
+ * point hardware.
+ *
+ * NOTE: due to the use of template, all functionalities of the filters
+ * are implemented directly in the `simpleFilters.h` header file. In other
+ * words, there is no separated `.cpp` file.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#ifndef SIMPLE_EVENTS_FILTERS_H_
+#define SIMPLE_EVENTS_FILTERS_H_
+
+/**
+ * class declaration for the SimpleMovingAverage class.
+ * @param - NO input parameters to the constructor. However, template
+ *     parameters that controls the number of samples averaged, the type of
+ *     the samples, and the type of the running sum (which must hold N times
+ *     the largest sample) may optionally be supplied.
+ */
+template <int N = 8, typename T = int, typename Acc_t = long>
+class SimpleMovingAverage {
+
+  private:
+    T history[N] = { 0 };
+    Acc_t sum = 0;
+    int pos = 0;
+    T last = 0;
+
+  public:
+    T update(T);
+    T value();
+    void reset(T = 0);
+    void process(const T *, T *, int);
+};
+
+/**
+ * Filter one sample.
+ * @param sample - The new sample.
+ * @returns The average of the last N samples.
+ */
+template <int N, typename T, typename Acc_t>
+T SimpleMovingAverage<N, T, Acc_t>::update(T sample){
+
+    // running sum: add the newest sample and drop the oldest one
+    sum += (Acc_t) sample - (Acc_t) history[pos];
+    history[pos] = sample;
+    if (++pos == N) pos = 0;
+
+    last = (T) (sum / N);
+    return last;
+};
+
+/**
+ * Get the last filtered value.
+ * @param - No input parameter
+ * @returns The value returned by the last call to `.update()`.
+ */
+template <int N, typename T, typename Acc_t>
+T SimpleMovingAverage<N, T, Acc_t>::value(){
+    return last;
+};
+
+/**
+ * Fill the history with a given value, e.g., the first reading, so that the
+ * output does not have to ramp up from 0.
+ * @param fill - The value to fill the history with. Default = 0.
+ * @returns No explicit return.
+ */
+template <int N, typename T, typename Acc_t>
+void SimpleMovingAverage<N, T, Acc_t>::reset(T fill){
+
+    for (int k = 0; k < N; k++) history[k] = fill;
+    sum = (Acc_t) fill * N;
+    pos = 0;
+    last = fill;
+};
+
+/**
+ * Filter a block of samples, continuing from the current history.
+ * @param in - (Pointer to) the block of samples.
+ * @param out - (Pointer to) the block to store the filtered values in. May
+ *     be the same as `in`.
+ * @param count - The number of samples in the block.
+ * @returns No explicit return.
+ */
+template <int N, typename T, typename Acc_t>
+void SimpleMovingAverage<N, T, Acc_t>::process(
+    const T * in, T * out, int count
+) {
+    for (int k = 0; k < count; k++) out[k] = update(in[k]);
+};
+
+/**
+ * class declaration for the SimpleEMA (exponential moving average) class.
+ * @param - NO input parameters to the constructor. However, template
+ *     parameters that controls the smoothing factor (1 / 2^SHIFT), the type
+ *     of the samples, and the type of the internal state (which must hold
+ *     2^SHIFT times the largest sample) may optionally be supplied.
+ */
+template <int SHIFT = 3, typename T = int, typename Acc_t = long>
+class SimpleEMA {
+
+  private:
+    // the average, scaled up by 2^SHIFT to keep the fractional bits
+    Acc_t scaled = 0;
+
+  public:
+    T update(T);
+    T value();
+    void reset(T = 0);
+    void process(const T *, T *, int);
+};
+
+/**
+ * Filter one sample.
+ * @param sample - The new sample.
+ * @returns The updated exponential moving average.
+ */
+template <int SHIFT, typename T, typename Acc_t>
+T SimpleEMA<SHIFT, T, Acc_t>::update(T sample){
+
+    // avg += (sample - avg) / 2^SHIFT, done on the scaled-up average
+    scaled += (Acc_t) sample - (scaled >> SHIFT);
+    return (T) (scaled >> SHIFT);
+};
+
+/**
+ * Get the last filtered value.
+ * @param - No input parameter
+ * @returns The value returned by the last call to `.update()`.
+ */
+template <int SHIFT, typename T, typename Acc_t>
+T SimpleEMA<SHIFT, T, Acc_t>::value(){
+    return (T) (scaled >> SHIFT);
+};
+
+/**
+ * Set the average to a given value, e.g., the first reading, so that the
+ * output does not have to ramp up from 0.
+ * @param fill - The new value of the average. Default = 0.
+ * @returns No explicit return.
+ */
+template <int SHIFT, typename T, typename Acc_t>
+void SimpleEMA<SHIFT, T, Acc_t>::reset(T fill){
+    scaled = (Acc_t) fill << SHIFT;
+};
+
+/**
+ * Filter a block of samples, continuing from the current average.
+ * @param in - (Pointer to) the block of samples.
+ * @param out - (Pointer to) the block to store the filtered values in. May
+ *     be the same as `in`.
+ * @param count - The number of samples in the block.
+ * @returns No explicit return.
+ */
+template <int SHIFT, typename T, typename Acc_t>
+void SimpleEMA<SHIFT, T, Acc_t>::process(const T * in, T * out, int count){
+
+    // keep the state in a local so that it can live in registers
+    Acc_t acc = scaled;
+    for (int k = 0; k < count; k++){
+        acc += (Acc_t) in[k] - (acc >> SHIFT);
+        out[k] = (T) (acc >> SHIFT);
+    }
+    scaled = acc;
+};
+
+/**
+ * class declaration for the SimpleMedian class.
+ * @param - NO input parameters to the constructor. However, template
+ *     parameters that controls the number of samples (preferably odd, and
+ *     small since the cost grows as N^2) and the type of the samples may
+ *     optionally be supplied.
+ */
+template <int N = 3, typename T = int>
+class SimpleMedian {
+
+  private:
+    T history[N] = { 0 };
+    int pos = 0;
+    T last = 0;
+
+  public:
+    T update(T);
+    T value();
+    void reset(T = 0);
+    void process(const T *, T *, int);
+};
+
+/**
+ * Filter one sample.
+ * @param sample - The new sample.
+ * @returns The median of the last N samples.
+ */
+template <int N, typename T>
+T SimpleMedian<N, T>::update(T sample){
+
+    T sorted[N];
+    int i, j;
+
+    history[pos] = sample;
+    if (++pos == N) pos = 0;
+
+    // insertion sort of a copy of the history: N is small
+    for (i = 0; i < N; i++){
+        T x = history[i];
+        for (j = i; j > 0 && sorted[j - 1] > x; j--){
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = x;
+    }
+
+    last = sorted[N / 2];
+    return last;
+};
+
+/**
+ * Get the last filtered value.
+ * @param - No input parameter
+ * @returns The value returned by the last call to `.update()`.
+ */
+template <int N, typename T>
+T SimpleMedian<N, T>::value(){
+    return last;
+};
+
+/**
+ * Fill the history with a given value, e.g., the first reading.
+ * @param fill - The value to fill the history with. Default = 0.
+ * @returns No explicit return.
+ */
+template <int N, typename T>
+void SimpleMedian<N, T>::reset(T fill){
+
+    for (int k = 0; k < N; k++) history[k] = fill;
+    pos = 0;
+    last = fill;
+};
+
+/**
+ * Filter a block of samples, continuing from the current history.
+ * @param in - (Pointer to) the block of samples.
+ * @param out - (Pointer to) the block to store the filtered values in. May
+ *     be the same as `in`.
+ * @param count - The number of samples in the block.
+ * @returns No explicit return.
+ */
+template <int N, typename T>
+void SimpleMedian<N, T>::process(const T * in, T * out, int count){
+    for (int k = 0; k < count; k++) out[k] = update(in[k]);
+};
+
+/**
+ * class declaration for the SimpleFilterChain class, which runs two filter
+ * stages in series. Longer chains are built by nesting, e.g.,
+ * `SimpleFilterChain<SimpleMedian<3>, SimpleFilterChain<A, B> >`.
+ * @param - NO input parameters to the constructor. The template parameters
+ *     are the types of the first and second stage, and optionally the type
+ *     of the samples.
+ */
+template <typename First, typename Second, typename T = int>
+class SimpleFilterChain {
+
+  public:
+    First first;
+    Second second;
+
+    T update(T);
+    T value();
+    void reset(T = 0);
+    void process(const T *, T *, int);
+};
+
+/**
+ * Filter one sample through both stages.
+ * @param sample - The new sample.
+ * @returns The output of the second stage.
+ */
+template <typename First, typename Second, typename T>
+T SimpleFilterChain<First, Second, T>::update(T sample){
+    return second.update(first.update(sample));
+};
+
+/**
+ * Get the last filtered value.
+ * @param - No input parameter
+ * @returns The last output of the second stage.
+ */
+template <typename First, typename Second, typename T>
+T SimpleFilterChain<First, Second, T>::value(){
+    return second.value();
+};
+
+/**
+ * Reset both stages to the given value.
+ * @param fill - The value to reset both stages to. Default = 0.
+ * @returns No explicit return.
+ */
+template <typename First, typename Second, typename T>
+void SimpleFilterChain<First, Second, T>::reset(T fill){
+    first.reset(fill);
+    second.reset(fill);
+};
+
+/**
+ * Filter a block of samples through both stages, one stage at a time.
+ * @param in - (Pointer to) the block of samples.
+ * @param out - (Pointer to) the block to store the filtered values in. May
+ *     be the same as `in`.
+ * @param count - The number of samples in the block.
+ * @returns No explicit return.
+ */
+template <typename First, typename Second, typename T>
+void SimpleFilterChain<First, Second, T>::process(
+    const T * in, T * out, int count
+) {
+    first.process(in, out, count);
+    second.process(out, out, count);
+};
+
+#endif
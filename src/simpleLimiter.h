@@ -0,0 +1,235 @@
+/**
+ * @file Implement the `SimpleTokenBucket` and `SimpleLeakyBucket` classes,
+ * which limit how often a reaction (or any other code) may act.
+ *
+ * The debounce (timeout) of a reaction only allows one event per timeout,
+ * which cannot express a limit such as "at most 5 publishes per minute,
+ * possibly in a burst". The two classes here can:
+ *  + `SimpleTokenBucket` holds up to `capacity` tokens and gains one token
+ *    every `interval` ms. Each accepted event takes a token, so bursts of
+ *    up to `capacity` events are allowed, and the long-term rate is at most
+ *    one event per `interval`.
+ *  + `SimpleLeakyBucket` queues up to `capacity` events and lets them out
+ *    at most one per `interval` ms, so the output is smoothed to a steady
+ *    rate rather than passed through in bursts.
+ * Events that do not fit are rejected and counted.
+ *
+ * Neither class needs to be called on every loop: the tokens (or the queue)
+ * are updated lazily from the timestamp given when the bucket is used, so
+ * an idle bucket costs nothing.
+ *
+ * NOTE: all functionalities of the limiters are implemented directly in the
+ * `simpleLimiter.h` header file. In other words, there is no separated
+ * `.cpp` file.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#ifndef SIMPLE_EVENTS_LIMITER_H_
+#define SIMPLE_EVENTS_LIMITER_H_
+
+/**
+ * class declaration for the SimpleTokenBucket class.
+ * @param capacity - The maximum number of tokens, i.e., the largest burst.
+ * @param interval - Time (in ms) to gain one token.
+ */
+class SimpleTokenBucket {
+
+  private:
+    unsigned int capacity;
+    unsigned int tokens;
+    unsigned long interval;
+    unsigned long stamp = 0;
+    unsigned int n_rejected = 0;
+
+    void refill(unsigned long);
+
+  public:
+    SimpleTokenBucket(unsigned int, unsigned long);
+    bool tryAcquire(unsigned long = millis());
+    unsigned int available(unsigned long = millis());
+    unsigned int rejected();
+    void clearRejected();
+};
+
+/**
+ * Constructor of the SimpleTokenBucket class. The bucket starts full.
+ * @param capacity - The maximum number of tokens, i.e., the largest burst.
+ * @param interval - Time (in ms) to gain one token. An interval of 0 is
+ *     taken as 1.
+ */
+inline SimpleTokenBucket::SimpleTokenBucket(
+    unsigned int capacity, unsigned long interval
+) : capacity(capacity), tokens(capacity),
+    interval((interval > 0) ? interval : 1) {};
+
+/*
+ * Add the tokens gained since the last refill. Only called when the bucket
+ * is used, so an idle bucket costs nothing.
+ */
+inline void SimpleTokenBucket::refill(unsigned long now){
+
+    if (tokens >= capacity){
+        // full: the clock of the next token starts now
+        stamp = now;
+        return;
+    }
+
+    unsigned long gained = (now - stamp) / interval;
+    if (gained == 0) return;
+
+    if (gained >= capacity - tokens){
+        tokens = capacity;
+        stamp = now;
+    } else {
+        tokens += gained;
+        // no `now`: keep the fractional progress towards the next token
+        stamp += gained * interval;
+    }
+};
+
+/**
+ * Take a token if one is available. Typically called in a trigger, after
+ * the actual check, so that a rejected event does not trigger the reaction.
+ * @param now - The current time (in ms). Default = millis().
+ * @returns true if the event is accepted, false if it is rejected.
+ */
+inline bool SimpleTokenBucket::tryAcquire(unsigned long now){
+
+    refill(now);
+
+    if (tokens == 0){
+        n_rejected++;
+        return false;
+    }
+    tokens--;
+    return true;
+};
+
+/**
+ * Get the number of tokens available.
+ * @param now - The current time (in ms). Default = millis().
+ * @returns The number of events that would be accepted right now.
+ */
+inline unsigned int SimpleTokenBucket::available(unsigned long now){
+    refill(now);
+    return tokens;
+};
+
+/**
+ * Get the number of rejected events.
+ * @param - No input parameter
+ * @returns The number of rejected events since the last clearRejected().
+ */
+inline unsigned int SimpleTokenBucket::rejected(){
+    return n_rejected;
+};
+
+/**
+ * Reset the count of rejected events.
+ * @param - No input parameter
+ * @returns No explicit return.
+ */
+inline void SimpleTokenBucket::clearRejected(){
+    n_rejected = 0;
+};
+
+/**
+ * class declaration for the SimpleLeakyBucket class.
+ * @param capacity - The maximum number of queued events.
+ * @param interval - Minimum time (in ms) between two events let out.
+ */
+class SimpleLeakyBucket {
+
+  private:
+    unsigned int capacity;
+    unsigned int level = 0;
+    unsigned long interval;
+    unsigned long stamp = 0;
+    bool has_leaked = false;
+    unsigned int n_rejected = 0;
+
+  public:
+    SimpleLeakyBucket(unsigned int, unsigned long);
+    bool tryAdd();
+    bool ready(unsigned long = millis());
+    unsigned int pending();
+    unsigned int rejected();
+    void clearRejected();
+};
+
+/**
+ * Constructor of the SimpleLeakyBucket class. The bucket starts empty.
+ * @param capacity - The maximum number of queued events.
+ * @param interval - Minimum time (in ms) between two events let out.
+ */
+inline SimpleLeakyBucket::SimpleLeakyBucket(
+    unsigned int capacity, unsigned long interval
+) : capacity(capacity), interval(interval) {};
+
+/**
+ * Queue an event if there is room. Typically called in a trigger (or any
+ * other code) in place of acting on the event directly.
+ * @param - No input parameter
+ * @returns true if the event is queued, false if it is rejected.
+ */
+inline bool SimpleLeakyBucket::tryAdd(){
+
+    if (level >= capacity){
+        n_rejected++;
+        return false;
+    }
+    level++;
+    return true;
+};
+
+/**
+ * Let one queued event out, if the interval since the last one has passed.
+ * Intended to be wrapped in the trigger function of the reaction that
+ * acts on the events.
+ * @param now - The current time (in ms). Default = millis().
+ * @returns true if an event is let out (and should be acted upon).
+ */
+inline bool SimpleLeakyBucket::ready(unsigned long now){
+
+    if (level == 0) return false;
+    if (has_leaked && (now - stamp < interval)) return false;
+
+    level--;
+    stamp = now;
+    has_leaked = true;
+    return true;
+};
+
+/**
+ * Get the number of queued events.
+ * @param - No input parameter
+ * @returns The number of events waiting to be let out.
+ */
+inline unsigned int SimpleLeakyBucket::pending(){
+    return level;
+};
+
+/**
+ * Get the number of rejected events.
+ * @param - No input parameter
+ * @returns The number of rejected events since the last clearRejected().
+ */
+inline unsigned int SimpleLeakyBucket::rejected(){
+    return n_rejected;
+};
+
+/**
+ * Reset the count of rejected events.
+ * @param - No input parameter
+ * @returns No explicit return.
+ */
+inline void SimpleLeakyBucket::clearRejected(){
+    n_rejected = 0;
+};
+
+#endif
@@ -0,0 +1,104 @@
+/**
+ * @file Implement a `SimpleRing` class, the pair of counters behind the
+ * lock-free rings of `SimpleSampler`, `SimpleChannel`, and `SimpleEventBus`.
+ *
+ * A ring of CAP slots (a power of 2, at most 128) is shared by a single
+ * producer and a single consumer: the producer only ever advances the count
+ * of slots written (`.publish()`), and the consumer only ever advances the
+ * count of slots read (`.release()`). Both counts are single bytes, so they
+ * are updated atomically even on 8-bit controllers, and the producer may be
+ * an interrupt service routine. The counts are free-running, i.e., they
+ * wrap around at 256 rather than at CAP, so that a full ring and an empty
+ * ring can be told apart without a separate flag.
+ *
+ * The class only keeps the counters: the slots themselves are kept by the
+ * owner of the ring, and indexed via `.headSlot()` and `.tailSlot()`.
+ *
+ * NOTE: due to the use of template, all functionalities of the `SimpleRing`
+ * class are implemented directly in the `simpleRing.h` header file. In
+ * other words, there is no separated `.cpp` file.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#ifndef SIMPLE_EVENTS_RING_H_
+#define SIMPLE_EVENTS_RING_H_
+
+/**
+ * class declaration for the SimpleRing class.
+ * @param - NO input parameters to the constructor. The template parameter
+ *     is the number of slots of the ring (a power of 2, at most 128).
+ */
+template <int CAP>
+class SimpleRing {
+
+    static_assert(
+        CAP > 0 && CAP <= 128 && (CAP & (CAP - 1)) == 0,
+        "the capacity of a ring must be a power of 2 between 1 and 128"
+    );
+
+  private:
+    volatile unsigned char written = 0;   // advanced by the producer only
+    volatile unsigned char taken = 0;     // advanced by the consumer only
+
+  public:
+    /**
+     * Get the number of slots written but not yet read.
+     * @param - No input parameter
+     * @returns The number of slots in use, from 0 to CAP.
+     */
+    unsigned char count(){
+        // the difference of the free-running counts, taken modulo 256
+        return (unsigned char) (written - taken);
+    };
+
+    /**
+     * Check whether all slots are in use, i.e., the producer must not write.
+     * @param - No input parameter
+     * @returns true if the ring is full.
+     */
+    bool isFull(){ return count() >= CAP; };
+
+    /**
+     * Check whether no slot is in use, i.e., the consumer has nothing to read.
+     * @param - No input parameter
+     * @returns true if the ring is empty.
+     */
+    bool isEmpty(){ return written == taken; };
+
+    /**
+     * Get the slot that the producer writes into next.
+     * @param - No input parameter
+     * @returns The index of the slot, from 0 to CAP - 1.
+     */
+    int headSlot(){ return written & (CAP - 1); };
+
+    /**
+     * Get the slot that the consumer reads next.
+     * @param - No input parameter
+     * @returns The index of the slot, from 0 to CAP - 1.
+     */
+    int tailSlot(){ return taken & (CAP - 1); };
+
+    /**
+     * Hand the head slot over to the consumer. Called by the producer only,
+     * and only after the slot is written.
+     * @param - No input parameter
+     * @returns No explicit return.
+     */
+    void publish(){ written = written + 1; };
+
+    /**
+     * Hand the tail slot back to the producer. Called by the consumer only,
+     * and only after the slot is read.
+     * @param - No input parameter
+     * @returns No explicit return.
+     */
+    void release(){ taken = taken + 1; };
+};
+
+#endif
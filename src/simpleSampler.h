@@ -0,0 +1,171 @@
+/**
+ * @file Implement a `SimpleSampler` class that buffers samples taken at a
+ * fixed rate and hands them over to a processing callback in blocks.
+ *
+ * The samples are written one at a time by `.push()`, typically called from
+ * a high-rate schedule or from a timer interrupt, into a ring of fixed-size
+ * blocks. Once a block is full, it becomes available to the consumer, which
+ * is typically a reaction whose trigger checks `.ready()`. The consumer
+ * then receives the whole block as a contiguous array, so per-sample
+ * overhead is only paid by the (cheap) producer.
+ *
+ * The ring is lock-free for a single producer and a single consumer (see
+ * `SimpleRing`): the producer only ever advances the count of filled blocks,
+ * and the consumer only ever advances the count of consumed blocks. If the
+ * consumer falls behind and all blocks are full, new samples are dropped
+ * and counted as overruns.
+ *
+ * NOTE: due to the use of template, all functionalities of the
+ * `SimpleSampler` class are implemented directly in the `simpleSampler.h`
+ * header file. In other words, there is no separated `.cpp` file.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#ifndef SIMPLE_EVENTS_SAMPLER_H_
+#define SIMPLE_EVENTS_SAMPLER_H_
+
+#include "simpleRing.h"
+
+/**
+ * class declaration for the SimpleSampler class.
+ * @param - NO input parameters to the constructor. However, template
+ *     parameters that controls the type of the samples, the number of
+ *     samples per block, and the number of blocks in the ring (a power of 2,
+ *     at most 128) may optionally be supplied.
+ */
+template <typename T = int, int BLOCK = 64, int N_BLOCKS = 2>
+class SimpleSampler {
+
+  private:
+    T samples[N_BLOCKS][BLOCK];
+
+    int write_pos = 0;                   // owned by the producer
+    SimpleRing<N_BLOCKS> blocks;         // full blocks, see SimpleRing
+    volatile unsigned int dropped = 0;   // advanced by the producer only
+
+  public:
+    bool push(T);
+    bool ready();
+    const T * block();
+    void release();
+    bool process(void (*)(const T *, int));
+    unsigned int overruns();
+    void clearOverruns();
+};
+
+/**
+ * Append a sample to the block being filled. Intended to be called by the
+ * producer (a schedule or an interrupt service routine).
+ * @param sample - The new sample.
+ * @returns true if the sample is stored, false if it is dropped because all
+ *     blocks are waiting to be processed.
+ */
+template <typename T, int BLOCK, int N_BLOCKS>
+bool SimpleSampler<T, BLOCK, N_BLOCKS>::push(T sample){
+
+    if (blocks.isFull()){
+        // failure: consumer is behind, no free block to write into
+        dropped = dropped + 1;
+        return false;
+    }
+
+    samples[blocks.headSlot()][write_pos] = sample;
+
+    if (++write_pos == BLOCK){
+        write_pos = 0;
+        // publishing the block is last, after the sample is stored
+        blocks.publish();
+    }
+    return true;
+};
+
+/**
+ * Check whether a full block is waiting to be processed. Intended to be
+ * wrapped in a trigger function.
+ * @param - No input parameter
+ * @returns true if `.block()` would return a full block.
+ */
+template <typename T, int BLOCK, int N_BLOCKS>
+bool SimpleSampler<T, BLOCK, N_BLOCKS>::ready(){
+    return !blocks.isEmpty();
+};
+
+/**
+ * Access the oldest full block. The block stays valid (and is not written
+ * into by the producer) until `.release()` is called.
+ * @param - No input parameter
+ * @returns (Pointer to) the first of `BLOCK` contiguous samples, or nullptr
+ *     if no block is ready.
+ */
+template <typename T, int BLOCK, int N_BLOCKS>
+const T * SimpleSampler<T, BLOCK, N_BLOCKS>::block(){
+
+    if (!ready()) return nullptr;
+    return samples[blocks.tailSlot()];
+};
+
+/**
+ * Hand the oldest full block back to the producer.
+ * @param - No input parameter
+ * @returns No explicit return.
+ */
+template <typename T, int BLOCK, int N_BLOCKS>
+void SimpleSampler<T, BLOCK, N_BLOCKS>::release(){
+
+    if (!ready()) return;
+    blocks.release();
+};
+
+/**
+ * Process the oldest full block (if any) with the callback, then release
+ * it. Intended to be called from the callback of a reaction.
+ * @param callback - (Pointer to) function that receives the block as an
+ *     array of samples together with the number of samples.
+ * @returns true if a block is processed.
+ */
+template <typename T, int BLOCK, int N_BLOCKS>
+bool SimpleSampler<T, BLOCK, N_BLOCKS>::process(
+    void (* callback)(const T *, int)
+) {
+    const T * data = block();
+
+    if (data == nullptr) return false;
+    (* callback)(data, BLOCK);
+    release();
+    return true;
+};
+
+/**
+ * Get the number of samples dropped because processing fell behind.
+ * @param - No input parameter
+ * @returns The number of dropped samples since the last clearOverruns().
+ */
+template <typename T, int BLOCK, int N_BLOCKS>
+unsigned int SimpleSampler<T, BLOCK, N_BLOCKS>::overruns(){
+
+    // counter is wider than a byte: read it with interrupts disabled
+    noInterrupts();
+    unsigned int count = dropped;
+    interrupts();
+    return count;
+};
+
+/**
+ * Reset the count of dropped samples.
+ * @param - No input parameter
+ * @returns No explicit return.
+ */
+template <typename T, int BLOCK, int N_BLOCKS>
+void SimpleSampler<T, BLOCK, N_BLOCKS>::clearOverruns(){
+
+    noInterrupts();
+    dropped = 0;
+    interrupts();
+};
+
+#endif
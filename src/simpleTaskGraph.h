@@ -0,0 +1,204 @@
+/**
+ * @file Implement a `SimpleTaskGraph` class that runs a set of tasks in
+ * dependency order, e.g., "read sensors, then filter, then publish".
+ *
+ * Each task (node) is a function that returns true once it has completed.
+ * A node may depend on any number of other nodes, and runs only after all
+ * of them have completed (fan-in). Since the nodes are kept in dependency
+ * (topological) order, a single `.run()` walks through the graph once and
+ * runs every node whose dependencies have just completed, so a whole chain
+ * of tasks completes within the same iteration of the event loop rather
+ * than one stage per iteration.
+ *
+ * A node that returns false (e.g., because its data is not ready yet) is
+ * run again by the next `.run()`, while the nodes that have completed are
+ * not; once every node has completed, the next `.run()` starts a new round.
+ * The graph is checked for cycles when it is built, and all storage is
+ * fixed in size.
+ *
+ * In typical use case, the nodes and dependencies are added in `setup()`,
+ * followed by `.build()`, and `.run()` is called from a schedule of
+ * `SimpleEvents` (e.g., once every 100 ms).
+ *
+ * NOTE: due to the use of template, all functionalities of the
+ * `SimpleTaskGraph` class are implemented directly in the
+ * `simpleTaskGraph.h` header file. In other words, there is no separated
+ * `.cpp` file.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#ifndef SIMPLE_EVENTS_TASK_GRAPH_H_
+#define SIMPLE_EVENTS_TASK_GRAPH_H_
+
+// typedef for the node function: returns true once the task has completed
+typedef bool simpleTaskGraphNode();
+
+/**
+ * class declaration for the SimpleTaskGraph class.
+ * @param - NO input parameters to the constructor. However, a template
+ *     parameter that controls the maximum number of nodes (at most 32) may
+ *     optionally be supplied.
+ */
+template <int N_MAX = 8>
+class SimpleTaskGraph {
+
+    static_assert(N_MAX <= 32, "SimpleTaskGraph: at most 32 nodes");
+
+  private:
+    int last_node = -1;
+    bool is_built = false;
+
+    simpleTaskGraphNode * node_calls[N_MAX] = { nullptr };
+    // bit j of node_deps[i] is set if node i depends on node j
+    uint32_t node_deps[N_MAX] = { 0 };
+    // node ids in topological order, as found by .build()
+    unsigned char order[N_MAX] = { 0 };
+
+    // bit i is set once node i has completed in the current round
+    uint32_t done = 0;
+
+  public:
+    int addNode(simpleTaskGraphNode *);
+    bool addDependency(int, int);
+    bool build();
+    bool run();
+    void reset();
+    bool isDone(int);
+};
+
+/**
+ * Add a new node (task) to the graph.
+ * @param callback - (Pointer to) function that runs the task, and returns
+ *     true once it has completed.
+ * @returns the id of the node, -1 if the maximum number of nodes is reached.
+ */
+template <int N_MAX>
+int SimpleTaskGraph<N_MAX>::addNode(simpleTaskGraphNode * callback){
+
+    if (last_node >= N_MAX - 1) return -1;
+
+    node_calls[++last_node] = callback;
+    is_built = false;
+
+    return last_node;
+};
+
+/**
+ * Make a node wait for another node to complete.
+ * @param node - The id of the dependent node.
+ * @param prerequisite - The id of the node it waits for.
+ * @returns true if added, false if either id is invalid.
+ */
+template <int N_MAX>
+bool SimpleTaskGraph<N_MAX>::addDependency(int node, int prerequisite){
+
+    if ( (node < 0) || (node > last_node) ) return false;
+    if ( (prerequisite < 0) || (prerequisite > last_node) ) return false;
+
+    node_deps[node] |= ((uint32_t) 1 << prerequisite);
+    is_built = false;
+
+    return true;
+};
+
+/**
+ * Sort the nodes in topological order (with Kahn's algorithm), which also
+ * detects cycles. The `.build()` method should be called AFTER all nodes
+ * and dependencies are added, but BEFORE `.run()` is ever called.
+ * @param - No input parameter
+ * @returns true if the graph is built, false if the dependencies form a
+ *     cycle (in which case `.run()` does nothing).
+ */
+template <int N_MAX>
+bool SimpleTaskGraph<N_MAX>::build(){
+
+    uint32_t placed = 0;
+    uint32_t bit;
+    int n = 0;
+    int i;
+    bool progress = true;
+
+    // repeatedly place every node whose dependencies are all placed
+    while (progress){
+        progress = false;
+        for (i = 0; i <= last_node; i++){
+            bit = ((uint32_t) 1 << i);
+            if ( !(placed & bit) && ((node_deps[i] & ~placed) == 0) ){
+                order[n++] = (unsigned char) i;
+                placed |= bit;
+                progress = true;
+            }
+        }
+    }
+
+    // nodes left over wait on each other, i.e., there is a cycle
+    is_built = (n == last_node + 1);
+    done = 0;
+
+    return is_built;
+};
+
+/**
+ * Run, in dependency order, every node that has not completed yet in the
+ * current round and whose dependencies all have. Nodes released by a node
+ * that completes are run in the same call.
+ *
+ * In typical use case, `.run()` is called from a schedule of `SimpleEvents`.
+ *
+ * @param - No input parameter
+ * @returns true if the round completed in this call (every node has
+ *     completed), false otherwise.
+ */
+template <int N_MAX>
+bool SimpleTaskGraph<N_MAX>::run(){
+
+    if (!is_built || (last_node < 0)) return false;
+
+    uint32_t all, bit;
+    int n, i;
+
+    // mask of all nodes (shifting by 32 is not defined, hence the split)
+    all = (last_node == 31) ?
+        0xFFFFFFFFUL : (((uint32_t) 1 << (last_node + 1)) - 1);
+
+    // the previous round completed: start a new one
+    if (done == all) done = 0;
+
+    for (n = 0; n <= last_node; n++){
+        i = order[n];
+        bit = ((uint32_t) 1 << i);
+        if ( (done & bit) || (node_deps[i] & ~done) ) continue;
+        if ((* node_calls[i])()) done |= bit;
+    }
+
+    return (done == all);
+};
+
+/**
+ * Abandon the current round, so that the next `.run()` starts a new round
+ * from the nodes without dependencies.
+ * @param - No input parameter
+ * @returns No explicit return.
+ */
+template <int N_MAX>
+void SimpleTaskGraph<N_MAX>::reset(){
+    done = 0;
+};
+
+/**
+ * Check if a node has completed in the current round.
+ * @param node - The id of the node.
+ * @returns true if the node has completed, false otherwise.
+ */
+template <int N_MAX>
+bool SimpleTaskGraph<N_MAX>::isDone(int node){
+    if ( (node < 0) || (node > last_node) ) return false;
+    return (done & ((uint32_t) 1 << node)) != 0;
+};
+
+#endif
@@ -0,0 +1,183 @@
+/**
+ * @file Implement a `SimpleThreshold` class that turns an analog input into
+ * triggers for `SimpleEvents` and `TinyEvents`, with hysteresis and
+ * rate-limited sampling.
+ *
+ * Calling `analogRead()` inside a trigger means one ADC conversion (about
+ * 100 us on 8-bit AVR) per loop. Instead, the `.sample()` method of
+ * `SimpleThreshold` is meant to be called from a schedule, so that the
+ * input is read at a rate set by the schedule interval. Each sample may be
+ * averaged over several conversions (oversampling), and is compared
+ * against a pair of thresholds (the hysteresis band): the input is
+ * considered "high" once it rises to the upper threshold, and "low" once
+ * it falls to the lower threshold, so noise around a single threshold
+ * does not cause chatter.
+ *
+ * The `.crossedUp()` and `.crossedDown()` methods report band crossings
+ * only, and can be used (via small wrapper functions) as the triggers of
+ * reactions. Since they merely check a flag, checking them every loop
+ * costs no ADC conversion.
+ *
+ * NOTE: all functionalities of the `SimpleThreshold` class are implemented
+ * directly in the `simpleThreshold.h` header file. In other words, there is
+ * no separated `.cpp` file.
+ */
+
+/**
+ * @author Wing-Ho Ko
+ * @copyright 2024 Wing-Ho Ko
+ * @license MIT
+ */
+
+#ifndef SIMPLE_EVENTS_THRESHOLD_H_
+#define SIMPLE_EVENTS_THRESHOLD_H_
+
+/**
+ * class declaration for the SimpleThreshold class.
+ * @param pin - The analog pin to read from.
+ * @param low - The lower threshold: the input becomes "low" when the
+ *     (averaged) reading is at or below this value.
+ * @param high - The upper threshold: the input becomes "high" when the
+ *     (averaged) reading is at or above this value.
+ * @param oversample - The number of ADC conversions averaged per sample.
+ *     Default = 1 (no oversampling).
+ */
+class SimpleThreshold {
+
+  private:
+    uint8_t pin;
+    uint8_t oversample;
+    int low;
+    int high;
+
+    int last_value = 0;
+    int8_t state = 0; // 1 = high, -1 = low, 0 = not yet sampled
+    bool is_up = false;
+    bool is_down = false;
+
+  public:
+    SimpleThreshold(uint8_t, int, int, uint8_t = 1);
+    void setThresholds(int, int);
+    void sample();
+    void update(int);
+    bool crossedUp();
+    bool crossedDown();
+    bool isHigh();
+    int value();
+};
+
+/**
+ * Constructor of the SimpleThreshold class.
+ * @param pin - The analog pin to read from.
+ * @param low - The lower threshold of the hysteresis band.
+ * @param high - The upper threshold of the hysteresis band.
+ * @param oversample - The number of ADC conversions averaged per sample.
+ *     Default = 1.
+ */
+inline SimpleThreshold::SimpleThreshold(
+    uint8_t pin, int low, int high, uint8_t oversample
+) : pin(pin), oversample((oversample < 1) ? 1 : oversample),
+    low(low), high(high) {};
+
+/**
+ * Change the thresholds of the hysteresis band. The current state (high
+ * or low) is kept until the next crossing.
+ * @param low - The lower threshold of the hysteresis band.
+ * @param high - The upper threshold of the hysteresis band.
+ * @returns No explicit return.
+ */
+inline void SimpleThreshold::setThresholds(int low, int high){
+    this->low = low;
+    this->high = high;
+};
+
+/**
+ * Read the analog input (averaged over `oversample` conversions) and
+ * register any band crossing. Intended to be the callback of a schedule,
+ * whose interval then sets the sampling rate.
+ *
+ * NOTE that the very first sample registers a crossing in the direction
+ * of the band it falls into (if any), so that the corresponding reaction
+ * can set up the initial state.
+ *
+ * @param - No input parameter
+ * @returns No explicit return.
+ */
+inline void SimpleThreshold::sample(){
+
+    long sum = 0;
+    uint8_t k;
+
+    for (k = 0; k < oversample; k++){
+        sum += analogRead(pin);
+    }
+    update((int) (sum / oversample));
+};
+
+/**
+ * Register any band crossing of a value read (and possibly filtered, see
+ * `simpleFilters.h`) by the caller, instead of reading the analog pin.
+ * Same as `.sample()` otherwise.
+ * @param reading - The new value of the input.
+ * @returns No explicit return.
+ */
+inline void SimpleThreshold::update(int reading){
+
+    last_value = reading;
+
+    if (last_value >= high && state != 1){
+        state = 1;
+        is_up = true;
+        is_down = false;
+    } else if (last_value <= low && state != -1){
+        state = -1;
+        is_down = true;
+        is_up = false;
+    }
+};
+
+/**
+ * Check (and clear) whether the input has crossed the upper threshold since
+ * the last call. Intended to be wrapped in a trigger function.
+ * @param - No input parameter
+ * @returns true if the input became "high" since the last call.
+ */
+inline bool SimpleThreshold::crossedUp(){
+
+    if (!is_up) return false;
+    is_up = false;
+    return true;
+};
+
+/**
+ * Check (and clear) whether the input has crossed the lower threshold since
+ * the last call. Intended to be wrapped in a trigger function.
+ * @param - No input parameter
+ * @returns true if the input became "low" since the last call.
+ */
+inline bool SimpleThreshold::crossedDown(){
+
+    if (!is_down) return false;
+    is_down = false;
+    return true;
+};
+
+/**
+ * Check whether the input is currently in the "high" state.
+ * @param - No input parameter
+ * @returns true if the last crossing was through the upper threshold.
+ */
+inline bool SimpleThreshold::isHigh(){
+    return state == 1;
+};
+
+/**
+ * Get the last (averaged) reading.
+ * @param - No input parameter
+ * @returns The last value given to (or computed by) `.update()`.
+ */
+inline int SimpleThreshold::value(){
+    return last_value;
+};
+
+#endif